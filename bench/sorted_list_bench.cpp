@@ -0,0 +1,614 @@
+/* Benchmarks of SelfOrganizingSortedList against std::multiset and std::list + sort.
+
+   Every case (implementation, operation, key distribution, size) runs in a forked child process, so the
+   peak RSS reported for it is its own. The child builds its inputs untimed, measures one operation and
+   sends the result back through a pipe. Allocations are counted by the global operator new below, only
+   inside the measured section. The peak RSS covers the whole child, including the input keys.
+
+   Usage: sorted_list_bench [--sizes=1000,10000,...] [--dists=sorted,reverse,random,zipf,dups]
+                            [--ops=insert,insert_pos,erase_pos,merge,unique,copy]
+                            [--impls=sosl,multiset,list] [--format=csv|json] [--output=path] [--seed=N] */
+
+#include "self_organizing_sorted_list.hpp"
+
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <new>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// GCC takes the replaced operator delete for a plain free() of memory from operator new
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace {
+
+std::atomic<long long> g_allocations(0);
+std::atomic<long long> g_allocated_bytes(0);
+
+} // namespace
+
+// Counting replacements of the global allocation functions, the nothrow forms call these by default
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocated_bytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    ::operator delete(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    ::operator delete(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    ::operator delete(memory);
+}
+
+namespace {
+
+using Key = int;
+using SortedList = SelfOrganizingSortedList<Key>;
+
+constexpr long long kPositionalBudget = 100000000; // Element steps allowed for the positional operations of one case
+constexpr int kMinPositionalOps = 10;
+constexpr int kMaxPositionalOps = 10000;
+constexpr int kDuplicateKeys = 100; // Distinct keys of the "dups" distribution
+constexpr int kZipfRanks = 1 << 20; // Most distinct keys of the "zipf" distribution
+constexpr double kZipfExponent = 1.0;
+
+volatile long long g_sink = 0; // Keeps the measured results alive
+
+// Result of one case, sent from the child to the parent as raw bytes
+struct Result
+{
+    long long m_ops; // Operations measured
+    long long m_ns; // Time of the measured section
+    long long m_allocations; // Calls of operator new in the measured section
+    long long m_bytes; // Bytes requested from operator new in the measured section
+    long m_peak_rss_kb; // Filled in by the parent
+    bool m_supported; // Whether the implementation has the operation
+};
+
+// Accumulates the time and allocations of the measured sections of a case
+class Measurement
+{
+public:
+    void start()
+    {
+        m_allocations_at_start = g_allocations.load(std::memory_order_relaxed);
+        m_bytes_at_start = g_allocated_bytes.load(std::memory_order_relaxed);
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    void stop()
+    {
+        const auto end = std::chrono::steady_clock::now();
+        m_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - m_start).count();
+        m_allocations += g_allocations.load(std::memory_order_relaxed) - m_allocations_at_start;
+        m_bytes += g_allocated_bytes.load(std::memory_order_relaxed) - m_bytes_at_start;
+    }
+
+    Result result(long long ops) const
+    {
+        return Result{ops, m_ns, m_allocations, m_bytes, 0, true};
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+    long long m_allocations_at_start = 0;
+    long long m_bytes_at_start = 0;
+    long long m_ns = 0;
+    long long m_allocations = 0;
+    long long m_bytes = 0;
+};
+
+struct Options
+{
+    std::vector<long long> m_sizes = {1000, 10000, 100000, 1000000, 10000000};
+    std::vector<std::string> m_dists = {"sorted", "reverse", "random", "zipf", "dups"};
+    std::vector<std::string> m_ops = {"insert", "insert_pos", "erase_pos", "merge", "unique", "copy"};
+    std::vector<std::string> m_impls = {"sosl", "multiset", "list"};
+    std::string m_format = "csv";
+    std::string m_output; // Standard output if empty
+    unsigned m_seed = 42;
+};
+
+// Function spreads the ranks of the Zipf distribution over the key space, so rank order is not key order.
+Key scatter(uint32_t rank)
+{
+    return static_cast<Key>((rank * 2654435761u) >> 1);
+}
+
+// Function generates n keys of a distribution in insertion order.
+std::vector<Key> make_keys(const std::string& dist, int n, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<Key> keys(n);
+
+    if (dist == "sorted" || dist == "reverse") {
+        for (int i = 0; i < n; ++i) {
+            keys[i] = dist == "sorted" ? i : n - 1 - i;
+        }
+    } else if (dist == "random") {
+        std::uniform_int_distribution<Key> uniform(0, std::numeric_limits<Key>::max());
+        for (Key& key : keys) {
+            key = uniform(rng);
+        }
+    } else if (dist == "zipf") {
+        // Inverse transform sampling over the cumulative weights of the ranks
+        const int ranks = std::min(n, kZipfRanks);
+        std::vector<double> cumulative(ranks);
+        double total = 0;
+        for (int rank = 0; rank < ranks; ++rank) {
+            total += 1.0 / std::pow(rank + 1, kZipfExponent);
+            cumulative[rank] = total;
+        }
+        std::uniform_real_distribution<double> uniform(0, total);
+        for (Key& key : keys) {
+            const auto rank = std::lower_bound(cumulative.begin(), cumulative.end(), uniform(rng)) - cumulative.begin();
+            key = scatter(static_cast<uint32_t>(std::min<std::ptrdiff_t>(rank, ranks - 1)));
+        }
+    } else if (dist == "dups") {
+        std::uniform_int_distribution<Key> uniform(0, kDuplicateKeys - 1);
+        for (Key& key : keys) {
+            key = uniform(rng);
+        }
+    } else {
+        throw std::runtime_error("Unknown distribution " + dist);
+    }
+    return keys;
+}
+
+// Function picks how many positional operations a case measures, so a linear walk per operation stays affordable.
+int positional_ops(int n)
+{
+    const long long ops = kPositionalBudget / std::max(n, 1);
+    return static_cast<int>(std::max<long long>(kMinPositionalOps, std::min<long long>(kMaxPositionalOps, ops)));
+}
+
+// Function draws the positions of 'ops' insertions (grow > 0) or erasures (grow < 0) into a container of n elements.
+std::vector<int> make_positions(int n, int ops, int grow, std::mt19937& rng)
+{
+    std::vector<int> positions(ops);
+    for (int i = 0; i < ops; ++i) {
+        const int size = n + grow * i;
+        positions[i] = static_cast<int>(rng() % static_cast<unsigned>(grow > 0 ? size + 1 : size));
+    }
+    return positions;
+}
+
+// Function builds the list untimed, with as many threads as there are cores.
+SortedList build_list(const std::vector<Key>& keys)
+{
+    const int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    return SortedList(keys.begin(), keys.end(), threads);
+}
+
+// Function builds a std::list sorted as the "list + sort" baseline keeps it.
+std::list<Key> build_sorted_std_list(const std::vector<Key>& keys)
+{
+    std::list<Key> list(keys.begin(), keys.end());
+    list.sort();
+    return list;
+}
+
+// Function measures one operation of SelfOrganizingSortedList.
+Result run_sosl(const std::string& op, const std::vector<Key>& keys, std::mt19937& rng)
+{
+    const int n = static_cast<int>(keys.size());
+    Measurement measurement;
+
+    if (op == "insert") {
+        SortedList list;
+        measurement.start();
+        for (Key key : keys) {
+            list.push_back(key);
+        }
+        measurement.stop();
+        g_sink += list.size();
+        return measurement.result(n);
+    }
+    if (op == "insert_pos" || op == "erase_pos") {
+        const bool insert = op == "insert_pos";
+        const int ops = insert ? positional_ops(n) : std::min(n, positional_ops(n));
+        const std::vector<int> positions = make_positions(n, ops, insert ? 1 : -1, rng);
+        SortedList list = build_list(keys);
+        measurement.start();
+        for (int i = 0; i < ops; ++i) {
+            if (insert) {
+                list.insert(keys[i % n], positions[i]);
+            } else {
+                list.erase(positions[i]);
+            }
+        }
+        measurement.stop();
+        g_sink += list.size();
+        return measurement.result(ops);
+    }
+    if (op == "merge") {
+        const std::vector<Key> first(keys.begin(), keys.begin() + n / 2);
+        const std::vector<Key> second(keys.begin() + n / 2, keys.end());
+        SortedList list = build_list(first);
+        SortedList other = build_list(second);
+        measurement.start();
+        list.merge(other);
+        measurement.stop();
+        g_sink += list.size();
+        return measurement.result(n);
+    }
+    if (op == "unique") {
+        SortedList list = build_list(keys);
+        measurement.start();
+        list.unique();
+        measurement.stop();
+        g_sink += list.size();
+        return measurement.result(n);
+    }
+    if (op == "copy") {
+        const SortedList list = build_list(keys);
+        measurement.start();
+        const SortedList copy(list);
+        measurement.stop();
+        g_sink += copy.size();
+        return measurement.result(n);
+    }
+    throw std::runtime_error("Unknown operation " + op);
+}
+
+// Function measures one operation of std::multiset, which has no positional insertion.
+Result run_multiset(const std::string& op, const std::vector<Key>& keys, std::mt19937& rng)
+{
+    const int n = static_cast<int>(keys.size());
+    Measurement measurement;
+
+    if (op == "insert") {
+        std::multiset<Key> set;
+        measurement.start();
+        for (Key key : keys) {
+            set.insert(key);
+        }
+        measurement.stop();
+        g_sink += static_cast<long long>(set.size());
+        return measurement.result(n);
+    }
+    if (op == "erase_pos") {
+        const int ops = std::min(n, positional_ops(n));
+        const std::vector<int> positions = make_positions(n, ops, -1, rng);
+        std::multiset<Key> set(keys.begin(), keys.end());
+        measurement.start();
+        for (int pos : positions) {
+            set.erase(std::next(set.begin(), pos));
+        }
+        measurement.stop();
+        g_sink += static_cast<long long>(set.size());
+        return measurement.result(ops);
+    }
+    if (op == "merge") {
+        std::multiset<Key> set(keys.begin(), keys.begin() + n / 2);
+        std::multiset<Key> other(keys.begin() + n / 2, keys.end());
+        measurement.start();
+        set.merge(other);
+        measurement.stop();
+        g_sink += static_cast<long long>(set.size());
+        return measurement.result(n);
+    }
+    if (op == "unique") {
+        std::multiset<Key> set(keys.begin(), keys.end());
+        measurement.start();
+        for (auto it = set.begin(); it != set.end();) {
+            const auto next = set.upper_bound(*it);
+            set.erase(std::next(it), next);
+            it = next;
+        }
+        measurement.stop();
+        g_sink += static_cast<long long>(set.size());
+        return measurement.result(n);
+    }
+    if (op == "copy") {
+        const std::multiset<Key> set(keys.begin(), keys.end());
+        measurement.start();
+        const std::multiset<Key> copy(set);
+        measurement.stop();
+        g_sink += static_cast<long long>(copy.size());
+        return measurement.result(n);
+    }
+    if (op == "insert_pos") {
+        Result result = Result();
+        result.m_supported = false;
+        return result;
+    }
+    throw std::runtime_error("Unknown operation " + op);
+}
+
+// Function measures one operation of std::list, sorted with list::sort() whenever the sorted order is needed.
+Result run_list(const std::string& op, const std::vector<Key>& keys, std::mt19937& rng)
+{
+    const int n = static_cast<int>(keys.size());
+    Measurement measurement;
+
+    if (op == "insert") {
+        std::list<Key> list;
+        measurement.start();
+        for (Key key : keys) {
+            list.push_back(key);
+        }
+        list.sort();
+        measurement.stop();
+        g_sink += static_cast<long long>(list.size());
+        return measurement.result(n);
+    }
+    if (op == "insert_pos" || op == "erase_pos") {
+        const bool insert = op == "insert_pos";
+        const int ops = insert ? positional_ops(n) : std::min(n, positional_ops(n));
+        const std::vector<int> positions = make_positions(n, ops, insert ? 1 : -1, rng);
+        std::list<Key> list(keys.begin(), keys.end());
+        measurement.start();
+        for (int i = 0; i < ops; ++i) {
+            if (insert) {
+                list.insert(std::next(list.begin(), positions[i]), keys[i % n]);
+            } else {
+                list.erase(std::next(list.begin(), positions[i]));
+            }
+        }
+        measurement.stop();
+        g_sink += static_cast<long long>(list.size());
+        return measurement.result(ops);
+    }
+    if (op == "merge") {
+        std::list<Key> list = build_sorted_std_list(std::vector<Key>(keys.begin(), keys.begin() + n / 2));
+        std::list<Key> other = build_sorted_std_list(std::vector<Key>(keys.begin() + n / 2, keys.end()));
+        measurement.start();
+        list.merge(other);
+        measurement.stop();
+        g_sink += static_cast<long long>(list.size());
+        return measurement.result(n);
+    }
+    if (op == "unique") {
+        std::list<Key> list = build_sorted_std_list(keys);
+        measurement.start();
+        list.unique();
+        measurement.stop();
+        g_sink += static_cast<long long>(list.size());
+        return measurement.result(n);
+    }
+    if (op == "copy") {
+        const std::list<Key> list = build_sorted_std_list(keys);
+        measurement.start();
+        const std::list<Key> copy(list);
+        measurement.stop();
+        g_sink += static_cast<long long>(copy.size());
+        return measurement.result(n);
+    }
+    throw std::runtime_error("Unknown operation " + op);
+}
+
+// Function runs one case in the current process.
+Result run_case(const std::string& impl, const std::string& op, const std::string& dist, int n, unsigned seed)
+{
+    const std::vector<Key> keys = make_keys(dist, n, seed);
+    std::mt19937 rng(seed + 1);
+
+    if (impl == "sosl") {
+        return run_sosl(op, keys, rng);
+    }
+    if (impl == "multiset") {
+        return run_multiset(op, keys, rng);
+    }
+    if (impl == "list") {
+        return run_list(op, keys, rng);
+    }
+    throw std::runtime_error("Unknown implementation " + impl);
+}
+
+// Function runs one case in a child process and collects its result and peak RSS, returns false if the child failed.
+bool run_isolated(const std::string& impl, const std::string& op, const std::string& dist, int n, unsigned seed, Result& result)
+{
+    int channel[2];
+    if (::pipe(channel) != 0) {
+        throw std::runtime_error("Cannot create a pipe");
+    }
+
+    const pid_t child = ::fork();
+    if (child < 0) {
+        throw std::runtime_error("Cannot fork");
+    }
+    if (child == 0) {
+        ::close(channel[0]);
+        int status = 0;
+        try {
+            const Result measured = run_case(impl, op, dist, n, seed);
+            if (::write(channel[1], &measured, sizeof(measured)) != static_cast<ssize_t>(sizeof(measured))) {
+                status = 1;
+            }
+        } catch (const std::exception& error) {
+            std::cerr << impl << " " << op << " " << dist << " " << n << ": " << error.what() << std::endl;
+            status = 1;
+        }
+        ::_exit(status);
+    }
+
+    ::close(channel[1]);
+    const ssize_t received = ::read(channel[0], &result, sizeof(result));
+    ::close(channel[0]);
+
+    int status = 0;
+    struct rusage usage;
+    if (::wait4(child, &status, 0, &usage) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0 || received != static_cast<ssize_t>(sizeof(result))) {
+        return false;
+    }
+
+    // ru_maxrss is in kilobytes on Linux and in bytes on macOS
+#ifdef __APPLE__
+    result.m_peak_rss_kb = usage.ru_maxrss / 1024;
+#else
+    result.m_peak_rss_kb = usage.ru_maxrss;
+#endif
+    return true;
+}
+
+// Function splits a comma separated list.
+std::vector<std::string> split(const std::string& text)
+{
+    std::vector<std::string> parts;
+    std::stringstream stream(text);
+    std::string part;
+    while (std::getline(stream, part, ',')) {
+        if (!part.empty()) {
+            parts.push_back(part);
+        }
+    }
+    return parts;
+}
+
+// Function reads the command line options.
+Options parse_options(int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const size_t equals = arg.find('=');
+        const std::string name = arg.substr(0, equals);
+        const std::string value = equals == std::string::npos ? std::string() : arg.substr(equals + 1);
+
+        if (name == "--sizes") {
+            options.m_sizes.clear();
+            for (const std::string& size : split(value)) {
+                options.m_sizes.push_back(static_cast<long long>(std::stod(size)));
+            }
+        } else if (name == "--dists") {
+            options.m_dists = split(value);
+        } else if (name == "--ops") {
+            options.m_ops = split(value);
+        } else if (name == "--impls") {
+            options.m_impls = split(value);
+        } else if (name == "--format" && (value == "csv" || value == "json")) {
+            options.m_format = value;
+        } else if (name == "--output") {
+            options.m_output = value;
+        } else if (name == "--seed") {
+            options.m_seed = static_cast<unsigned>(std::stoul(value));
+        } else {
+            throw std::runtime_error("Unknown option " + arg);
+        }
+    }
+
+    for (long long size : options.m_sizes) {
+        if (size < 2 || size > std::numeric_limits<int>::max()) {
+            throw std::runtime_error("Sizes must be between 2 and INT_MAX");
+        }
+    }
+    return options;
+}
+
+// Function writes one result as a CSV line or a JSON object.
+void write_result(std::ostream& out, const std::string& format, bool first, const std::string& impl, const std::string& op,
+                  const std::string& dist, long long n, const Result& result)
+{
+    const double ns_per_op = static_cast<double>(result.m_ns) / static_cast<double>(result.m_ops);
+    const double allocations_per_op = static_cast<double>(result.m_allocations) / static_cast<double>(result.m_ops);
+
+    if (format == "csv") {
+        out << impl << ',' << op << ',' << dist << ',' << n << ',' << result.m_ops << ',' << ns_per_op << ','
+            << result.m_allocations << ',' << allocations_per_op << ',' << result.m_bytes << ',' << result.m_peak_rss_kb << '\n';
+    } else {
+        out << (first ? "" : ",\n") << "  {\"impl\": \"" << impl << "\", \"op\": \"" << op << "\", \"dist\": \"" << dist
+            << "\", \"size\": " << n << ", \"ops\": " << result.m_ops << ", \"ns_per_op\": " << ns_per_op
+            << ", \"allocations\": " << result.m_allocations << ", \"allocations_per_op\": " << allocations_per_op
+            << ", \"bytes_allocated\": " << result.m_bytes << ", \"peak_rss_kb\": " << result.m_peak_rss_kb << "}";
+    }
+    out.flush();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    try {
+        const Options options = parse_options(argc, argv);
+
+        std::ofstream file;
+        if (!options.m_output.empty()) {
+            file.open(options.m_output);
+            if (!file) {
+                throw std::runtime_error("Cannot create " + options.m_output);
+            }
+        }
+        std::ostream& out = options.m_output.empty() ? std::cout : file;
+
+        if (options.m_format == "csv") {
+            out << "impl,op,dist,size,ops,ns_per_op,allocations,allocations_per_op,bytes_allocated,peak_rss_kb\n";
+        } else {
+            out << "[\n";
+        }
+
+        bool first = true;
+        int failures = 0;
+        for (long long n : options.m_sizes) {
+            for (const std::string& dist : options.m_dists) {
+                for (const std::string& op : options.m_ops) {
+                    for (const std::string& impl : options.m_impls) {
+                        Result result = Result();
+                        if (!run_isolated(impl, op, dist, static_cast<int>(n), options.m_seed, result)) {
+                            ++failures;
+                            continue;
+                        }
+                        if (!result.m_supported) {
+                            continue;
+                        }
+                        write_result(out, options.m_format, first, impl, op, dist, n, result);
+                        first = false;
+                    }
+                }
+            }
+        }
+
+        if (options.m_format == "json") {
+            out << "\n]\n";
+        }
+        return failures == 0 ? 0 : 1;
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return 2;
+    }
+}
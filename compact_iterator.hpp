@@ -0,0 +1,47 @@
+#ifndef COMPACT_ITERATOR_HPP_
+#define COMPACT_ITERATOR_HPP_
+
+#include "compact_node.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+// Read-only bidirectional iterator walking a chain of compact nodes through the 'Forward' and 'Backward'
+// index links. Like a vector iterator it refers to the node array, so it is invalidated by insertions.
+template <typename T, uint32_t CompactNode<T>::*Forward, uint32_t CompactNode<T>::*Backward>
+class CompactIterator
+{
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    CompactIterator(); // Default constructor
+    CompactIterator(const CompactNode<T>* nodes, uint32_t index, uint32_t last); // Iterator at 'index', 'last' is where decrementing the end leads
+
+public:
+    reference operator*() const;
+    pointer operator->() const;
+
+    CompactIterator& operator++(); // Moves to the following node
+    CompactIterator operator++(int);
+    CompactIterator& operator--(); // Moves to the preceding node
+    CompactIterator operator--(int);
+
+    bool operator==(const CompactIterator& other) const;
+    bool operator!=(const CompactIterator& other) const;
+
+    // Getters
+    uint32_t get_index() const;
+
+private:
+    const CompactNode<T>* m_nodes; // Node array of the list
+    uint32_t m_index; // Current node, kCompactNull is the end
+    uint32_t m_last; // Last node of the chain
+};
+
+#include "compact_iterator_impl_.hpp"
+
+#endif // COMPACT_ITERATOR_HPP_
@@ -0,0 +1,89 @@
+#ifndef COMPACT_ITERATOR_IMPL_HPP_
+#define COMPACT_ITERATOR_IMPL_HPP_
+
+// Default constructor
+template <typename T, uint32_t CompactNode<T>::*Forward, uint32_t CompactNode<T>::*Backward>
+CompactIterator<T, Forward, Backward>::CompactIterator()
+    : m_nodes(nullptr)
+    , m_index(kCompactNull)
+    , m_last(kCompactNull)
+{
+}
+
+// Constructor with the node array, the current node and the last node of the chain
+template <typename T, uint32_t CompactNode<T>::*Forward, uint32_t CompactNode<T>::*Backward>
+CompactIterator<T, Forward, Backward>::CompactIterator(const CompactNode<T>* nodes, uint32_t index, uint32_t last)
+    : m_nodes(nodes)
+    , m_index(index)
+    , m_last(last)
+{
+}
+
+// Return a reference to the data of the current node.
+template <typename T, uint32_t CompactNode<T>::*Forward, uint32_t CompactNode<T>::*Backward>
+typename CompactIterator<T, Forward, Backward>::reference CompactIterator<T, Forward, Backward>::operator*() const
+{
+    return m_nodes[m_index].m_data;
+}
+
+// Return a pointer to the data of the current node.
+template <typename T, uint32_t CompactNode<T>::*Forward, uint32_t CompactNode<T>::*Backward>
+typename CompactIterator<T, Forward, Backward>::pointer CompactIterator<T, Forward, Backward>::operator->() const
+{
+    return &m_nodes[m_index].m_data;
+}
+
+// Moves to the following node of the chain.
+template <typename T, uint32_t CompactNode<T>::*Forward, uint32_t CompactNode<T>::*Backward>
+CompactIterator<T, Forward, Backward>& CompactIterator<T, Forward, Backward>::operator++()
+{
+    m_index = m_nodes[m_index].*Forward;
+    return *this;
+}
+
+template <typename T, uint32_t CompactNode<T>::*Forward, uint32_t CompactNode<T>::*Backward>
+CompactIterator<T, Forward, Backward> CompactIterator<T, Forward, Backward>::operator++(int)
+{
+    CompactIterator tmp = *this;
+    ++*this;
+    return tmp;
+}
+
+// Moves to the preceding node of the chain, the end moves to the last node.
+template <typename T, uint32_t CompactNode<T>::*Forward, uint32_t CompactNode<T>::*Backward>
+CompactIterator<T, Forward, Backward>& CompactIterator<T, Forward, Backward>::operator--()
+{
+    m_index = m_index == kCompactNull ? m_last : m_nodes[m_index].*Backward;
+    return *this;
+}
+
+template <typename T, uint32_t CompactNode<T>::*Forward, uint32_t CompactNode<T>::*Backward>
+CompactIterator<T, Forward, Backward> CompactIterator<T, Forward, Backward>::operator--(int)
+{
+    CompactIterator tmp = *this;
+    --*this;
+    return tmp;
+}
+
+// Checks that both iterators point to the same node
+template <typename T, uint32_t CompactNode<T>::*Forward, uint32_t CompactNode<T>::*Backward>
+bool CompactIterator<T, Forward, Backward>::operator==(const CompactIterator& other) const
+{
+    return m_index == other.m_index;
+}
+
+// Checks that the iterators point to different nodes
+template <typename T, uint32_t CompactNode<T>::*Forward, uint32_t CompactNode<T>::*Backward>
+bool CompactIterator<T, Forward, Backward>::operator!=(const CompactIterator& other) const
+{
+    return !(*this == other);
+}
+
+// Return the index of the current node, kCompactNull for the end.
+template <typename T, uint32_t CompactNode<T>::*Forward, uint32_t CompactNode<T>::*Backward>
+uint32_t CompactIterator<T, Forward, Backward>::get_index() const
+{
+    return m_index;
+}
+
+#endif // COMPACT_ITERATOR_IMPL_HPP_
@@ -0,0 +1,30 @@
+#ifndef COMPACT_NODE_HPP_
+#define COMPACT_NODE_HPP_
+
+#include <cstdint>
+
+// Index standing for a missing node or lane
+constexpr uint32_t kCompactNull = 0xFFFFFFFFu;
+
+// Links of a compact node on one express lane above the sorted chain
+struct CompactLane
+{
+    uint32_t m_greater;
+    uint32_t m_lesser;
+};
+
+// Node of CompactSortedList. The links are 32-bit indices into the node array of the list, so the
+// whole structure is position independent and a node costs 24 bytes of links and lanes instead of 48.
+template <typename T>
+struct CompactNode
+{
+    uint32_t m_prev;
+    uint32_t m_next;
+    uint32_t m_greater;
+    uint32_t m_lesser;
+    uint32_t m_lanes; // First express lane in the lane array, level i + 1 is at m_lanes + i
+    int m_level; // Number of express lanes the node takes part in
+    T m_data;
+};
+
+#endif // COMPACT_NODE_HPP_
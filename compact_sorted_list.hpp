@@ -0,0 +1,125 @@
+#ifndef COMPACT_SORTED_LIST_HPP_
+#define COMPACT_SORTED_LIST_HPP_
+
+#include "compact_iterator.hpp"
+#include "compact_node.hpp"
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+/* Sorted list keeping the insertion order and the sorted order like SelfOrganizingSortedList, with all
+   nodes in one contiguous array and 32-bit index links instead of pointers. Released nodes and lanes are
+   reused through free lists. Since no link is an address, the list can be copied or moved as a whole
+   and traversals walk a dense array. */
+template <typename T, typename Compare = std::less<>>
+class CompactSortedList
+{
+public:
+    using value_type = T;
+    using key_compare = Compare;
+    using node_type = CompactNode<T>;
+
+    // Insertion order iterators, read-only since changing a value would break the order
+    using const_iterator = CompactIterator<T, &node_type::m_next, &node_type::m_prev>;
+    using iterator = const_iterator;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Sorted order iterators
+    using sorted_iterator = CompactIterator<T, &node_type::m_greater, &node_type::m_lesser>;
+    using reverse_sorted_iterator = std::reverse_iterator<sorted_iterator>;
+
+public:
+    CompactSortedList(); // Default constructor
+    explicit CompactSortedList(const Compare& compare); // Constructor with a comparator
+    CompactSortedList(std::initializer_list<T> init_list); // Constructor with initializer list
+
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    CompactSortedList(InputIt first, InputIt last); // Constructor with a range of values
+
+public:
+    // Modifiers
+    void push_back(const T& value); // Adds an element to the end
+    void push_back(T&& value);
+    void push_front(const T& value); // Inserts an element to the beginning
+    void push_front(T&& value);
+    void pop_back(); // Removes the last element
+    void pop_front(); // Removes the first element
+    void remove(const T& value); // Removes all equal elements
+    bool remove_one(const T& value); // Removes the first equal element in sorted order
+    void clear(); // Clears the contents
+    void shrink_to_fit(); // Returns unused capacity of the node and lane arrays
+    void swap(CompactSortedList<T, Compare>& other); // Swaps the contents
+
+    // Lookup
+    bool contains(const T& value) const; // Checks whether an equal element exists
+    sorted_iterator find(const T& value) const; // Finds the first equal element in sorted order
+    int count(const T& value) const; // Returns the number of equal elements
+    sorted_iterator lower_bound(const T& value) const; // First element not less than value
+    sorted_iterator upper_bound(const T& value) const; // First element greater than value
+
+    // Element access
+    const T& front() const; // Access the first element
+    const T& back() const; // Access the last element
+
+    // Iterators
+    const_iterator begin() const; // Insertion order
+    const_iterator end() const;
+    const_reverse_iterator rbegin() const; // Reverse insertion order
+    const_reverse_iterator rend() const;
+    sorted_iterator sorted_begin() const; // Ascending order
+    sorted_iterator sorted_end() const;
+    reverse_sorted_iterator sorted_rbegin() const; // Descending order
+    reverse_sorted_iterator sorted_rend() const;
+
+    // Capacity
+    bool empty() const; // Checks whether the container is empty
+    int size() const; // Returns the number of elements
+
+    // Prints
+    void print_next() const;
+    void print_prev() const;
+    void print_asc() const;
+    void print_desc() const;
+
+private:
+    template <typename Value>
+    void emplace_node(bool front, Value&& value); // Creates a node and links it into both orders
+    template <typename Value>
+    uint32_t create_node(Value&& value); // Takes a free node and its lanes from the arrays
+    void destroy_node(uint32_t elem); // Returns a node and its lanes to the free lists
+    void erase_node(uint32_t elem); // Unlinks a node from both orders and releases it
+    int random_level(); // Draws the number of express lanes for a new node
+
+    void put_in_sorted_order(uint32_t elem); // Links a node into the sorted chain and its lanes
+    void remove_sorted_node(uint32_t elem); // Unlinks a node from the sorted chain and its lanes
+    uint32_t find_sorted_predecessor(const T& value) const; // Last node less than value
+    uint32_t find_sorted_last_not_greater(const T& value) const; // Last node not greater than value
+    uint32_t& greater_link(uint32_t elem, int level); // 'greater' link at level, kCompactNull elem is the list head
+    uint32_t greater_link(uint32_t elem, int level) const;
+    uint32_t& lesser_link(uint32_t elem, int level); // 'lesser' link at level, kCompactNull elem is the list head
+    bool key_less(const T& lhs, const T& rhs) const; // Checks whether lhs is ordered before rhs
+
+private:
+    static constexpr int kMaxLevel = 16; // Supports about 4^16 elements with p = 1/4
+
+    std::vector<node_type> m_nodes; // Node storage, links are indices into it
+    std::vector<CompactLane> m_lanes; // Express lane storage
+    uint32_t m_free_nodes; // Released nodes, chained through m_next
+    uint32_t m_free_lanes[kMaxLevel]; // Released lane runs, m_free_lanes[i] holds runs of i + 1 lanes chained through m_greater
+    uint32_t m_head;
+    uint32_t m_tail;
+    uint32_t m_asc_head;
+    uint32_t m_desc_head;
+    int m_size;
+    CompactLane m_lane_heads[kMaxLevel]; // First (m_greater) and last (m_lesser) node of every express lane
+    int m_level; // Highest express lane in use
+    unsigned int m_seed; // State of the level generator
+    Compare m_compare; // Orders the elements
+};
+
+#include "compact_sorted_list_impl_.hpp"
+
+#endif // COMPACT_SORTED_LIST_HPP_
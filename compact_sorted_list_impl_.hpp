@@ -0,0 +1,626 @@
+#ifndef COMPACT_SORTED_LIST_IMPL_HPP_
+#define COMPACT_SORTED_LIST_IMPL_HPP_
+
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+// Default constructor
+template <typename T, typename Compare>
+CompactSortedList<T, Compare>::CompactSortedList()
+    : CompactSortedList(Compare())
+{
+}
+
+// Constructor with a comparator
+template <typename T, typename Compare>
+CompactSortedList<T, Compare>::CompactSortedList(const Compare& compare)
+    : m_nodes()
+    , m_lanes()
+    , m_free_nodes(kCompactNull)
+    , m_free_lanes()
+    , m_head(kCompactNull)
+    , m_tail(kCompactNull)
+    , m_asc_head(kCompactNull)
+    , m_desc_head(kCompactNull)
+    , m_size(0)
+    , m_lane_heads()
+    , m_level(0)
+    , m_seed(0x9E3779B9u)
+    , m_compare(compare)
+{
+    for (int i = 0; i < kMaxLevel; ++i) {
+        m_free_lanes[i] = kCompactNull;
+        m_lane_heads[i].m_greater = kCompactNull;
+        m_lane_heads[i].m_lesser = kCompactNull;
+    }
+}
+
+// Constructor with initializer list
+template <typename T, typename Compare>
+CompactSortedList<T, Compare>::CompactSortedList(std::initializer_list<T> init_list)
+    : CompactSortedList(init_list.begin(), init_list.end())
+{
+}
+
+// Constructor with a range of values
+template <typename T, typename Compare>
+template <typename InputIt, typename>
+CompactSortedList<T, Compare>::CompactSortedList(InputIt first, InputIt last)
+    : CompactSortedList()
+{
+    for (; first != last; ++first) {
+        push_back(*first);
+    }
+}
+
+// Adds a new node with the given value to the end of the list
+template <typename T, typename Compare>
+void CompactSortedList<T, Compare>::push_back(const T& value)
+{
+    emplace_node(false, value);
+}
+
+// Adds a new node to the end of the list, moving the given value into it
+template <typename T, typename Compare>
+void CompactSortedList<T, Compare>::push_back(T&& value)
+{
+    emplace_node(false, std::move(value));
+}
+
+// Adds a new node with the given value to the front of the list
+template <typename T, typename Compare>
+void CompactSortedList<T, Compare>::push_front(const T& value)
+{
+    emplace_node(true, value);
+}
+
+// Adds a new node to the front of the list, moving the given value into it
+template <typename T, typename Compare>
+void CompactSortedList<T, Compare>::push_front(T&& value)
+{
+    emplace_node(true, std::move(value));
+}
+
+// Removes the last element in insertion order.
+template <typename T, typename Compare>
+void CompactSortedList<T, Compare>::pop_back()
+{
+    // Check if the list is empty
+    if (m_tail == kCompactNull) {
+        throw std::runtime_error("List is empty. Cannot pop_back()");
+    }
+
+    erase_node(m_tail);
+}
+
+// Removes the first element in insertion order.
+template <typename T, typename Compare>
+void CompactSortedList<T, Compare>::pop_front()
+{
+    // Check if the list is empty
+    if (m_head == kCompactNull) {
+        throw std::runtime_error("List is empty. Cannot pop_front()");
+    }
+
+    erase_node(m_head);
+}
+
+// Function removes all elements equal to the given value. They form a run of the sorted chain, so only
+// that run is visited after a single search.
+template <typename T, typename Compare>
+void CompactSortedList<T, Compare>::remove(const T& value)
+{
+    uint32_t cur = lower_bound(value).get_index();
+    while (cur != kCompactNull && !key_less(value, m_nodes[cur].m_data)) {
+        // Remember the next node of the run before 'cur' is released
+        const uint32_t next = m_nodes[cur].m_greater;
+        erase_node(cur);
+        cur = next;
+    }
+}
+
+// Function removes the first element equal to the given value in sorted order, returns whether one was found.
+template <typename T, typename Compare>
+bool CompactSortedList<T, Compare>::remove_one(const T& value)
+{
+    const uint32_t elem = find(value).get_index();
+    if (elem == kCompactNull) {
+        return false;
+    }
+
+    erase_node(elem);
+    return true;
+}
+
+// Removes all elements and releases the node and lane arrays.
+template <typename T, typename Compare>
+void CompactSortedList<T, Compare>::clear()
+{
+    CompactSortedList<T, Compare> empty(m_compare);
+    swap(empty);
+}
+
+// Function returns unused capacity of the node and lane arrays. Released nodes in the middle stay on the free lists.
+template <typename T, typename Compare>
+void CompactSortedList<T, Compare>::shrink_to_fit()
+{
+    m_nodes.shrink_to_fit();
+    m_lanes.shrink_to_fit();
+}
+
+// Swaps the contents.
+template <typename T, typename Compare>
+void CompactSortedList<T, Compare>::swap(CompactSortedList<T, Compare>& other)
+{
+    m_nodes.swap(other.m_nodes);
+    m_lanes.swap(other.m_lanes);
+    std::swap(m_free_nodes, other.m_free_nodes);
+    std::swap(m_free_lanes, other.m_free_lanes);
+    std::swap(m_head, other.m_head);
+    std::swap(m_tail, other.m_tail);
+    std::swap(m_asc_head, other.m_asc_head);
+    std::swap(m_desc_head, other.m_desc_head);
+    std::swap(m_size, other.m_size);
+    std::swap(m_lane_heads, other.m_lane_heads);
+    std::swap(m_level, other.m_level);
+    std::swap(m_seed, other.m_seed);
+    std::swap(m_compare, other.m_compare);
+}
+
+// Function checks whether an element equal to the value exists.
+template <typename T, typename Compare>
+bool CompactSortedList<T, Compare>::contains(const T& value) const
+{
+    return find(value) != sorted_end();
+}
+
+// Function returns the first element equal to the value in sorted order, or sorted_end() if there is none.
+template <typename T, typename Compare>
+typename CompactSortedList<T, Compare>::sorted_iterator CompactSortedList<T, Compare>::find(const T& value) const
+{
+    sorted_iterator it = lower_bound(value);
+
+    // The first element not less than the value is a match unless it is greater
+    if (it != sorted_end() && key_less(value, *it)) {
+        return sorted_end();
+    }
+    return it;
+}
+
+// Function returns the number of elements equal to the value.
+template <typename T, typename Compare>
+int CompactSortedList<T, Compare>::count(const T& value) const
+{
+    int result = 0;
+    for (sorted_iterator it = lower_bound(value); it != sorted_end() && !key_less(value, *it); ++it) {
+        ++result;
+    }
+    return result;
+}
+
+// Function returns the first element in sorted order that is not less than the value.
+template <typename T, typename Compare>
+typename CompactSortedList<T, Compare>::sorted_iterator CompactSortedList<T, Compare>::lower_bound(const T& value) const
+{
+    const uint32_t prev = find_sorted_predecessor(value);
+    return sorted_iterator(m_nodes.data(), greater_link(prev, 0), m_desc_head);
+}
+
+// Function returns the first element in sorted order that is greater than the value.
+template <typename T, typename Compare>
+typename CompactSortedList<T, Compare>::sorted_iterator CompactSortedList<T, Compare>::upper_bound(const T& value) const
+{
+    const uint32_t prev = find_sorted_last_not_greater(value);
+    return sorted_iterator(m_nodes.data(), greater_link(prev, 0), m_desc_head);
+}
+
+// Return a reference to the first element in insertion order.
+template <typename T, typename Compare>
+const T& CompactSortedList<T, Compare>::front() const
+{
+    return m_nodes[m_head].m_data;
+}
+
+// Return a reference to the last element in insertion order.
+template <typename T, typename Compare>
+const T& CompactSortedList<T, Compare>::back() const
+{
+    return m_nodes[m_tail].m_data;
+}
+
+// Return an iterator to the first element in insertion order.
+template <typename T, typename Compare>
+typename CompactSortedList<T, Compare>::const_iterator CompactSortedList<T, Compare>::begin() const
+{
+    return const_iterator(m_nodes.data(), m_head, m_tail);
+}
+
+// Return an iterator past the last element in insertion order.
+template <typename T, typename Compare>
+typename CompactSortedList<T, Compare>::const_iterator CompactSortedList<T, Compare>::end() const
+{
+    return const_iterator(m_nodes.data(), kCompactNull, m_tail);
+}
+
+// Return a reverse iterator to the last element in insertion order.
+template <typename T, typename Compare>
+typename CompactSortedList<T, Compare>::const_reverse_iterator CompactSortedList<T, Compare>::rbegin() const
+{
+    return const_reverse_iterator(end());
+}
+
+// Return a reverse iterator past the first element in insertion order.
+template <typename T, typename Compare>
+typename CompactSortedList<T, Compare>::const_reverse_iterator CompactSortedList<T, Compare>::rend() const
+{
+    return const_reverse_iterator(begin());
+}
+
+// Return an iterator to the smallest element.
+template <typename T, typename Compare>
+typename CompactSortedList<T, Compare>::sorted_iterator CompactSortedList<T, Compare>::sorted_begin() const
+{
+    return sorted_iterator(m_nodes.data(), m_asc_head, m_desc_head);
+}
+
+// Return an iterator past the largest element.
+template <typename T, typename Compare>
+typename CompactSortedList<T, Compare>::sorted_iterator CompactSortedList<T, Compare>::sorted_end() const
+{
+    return sorted_iterator(m_nodes.data(), kCompactNull, m_desc_head);
+}
+
+// Return a reverse iterator to the largest element.
+template <typename T, typename Compare>
+typename CompactSortedList<T, Compare>::reverse_sorted_iterator CompactSortedList<T, Compare>::sorted_rbegin() const
+{
+    return reverse_sorted_iterator(sorted_end());
+}
+
+// Return a reverse iterator past the smallest element.
+template <typename T, typename Compare>
+typename CompactSortedList<T, Compare>::reverse_sorted_iterator CompactSortedList<T, Compare>::sorted_rend() const
+{
+    return reverse_sorted_iterator(sorted_begin());
+}
+
+// Checks if the list is empty.
+template <typename T, typename Compare>
+bool CompactSortedList<T, Compare>::empty() const
+{
+    return m_size == 0;
+}
+
+// Return the number of elements.
+template <typename T, typename Compare>
+int CompactSortedList<T, Compare>::size() const
+{
+    return m_size;
+}
+
+// Function prints the elements of the list in insertion order.
+template <typename T, typename Compare>
+void CompactSortedList<T, Compare>::print_next() const
+{
+    if (m_head == kCompactNull) {
+        std::cout << "List is empty" << std::endl;
+        return;
+    }
+
+    for (uint32_t cur = m_head; cur != kCompactNull; cur = m_nodes[cur].m_next) {
+        std::cout << m_nodes[cur].m_data << " ";
+    }
+    std::cout << std::endl;
+}
+
+// Function prints the elements of the list in reverse insertion order.
+template <typename T, typename Compare>
+void CompactSortedList<T, Compare>::print_prev() const
+{
+    if (m_tail == kCompactNull) {
+        std::cout << "List is empty" << std::endl;
+        return;
+    }
+
+    for (uint32_t cur = m_tail; cur != kCompactNull; cur = m_nodes[cur].m_prev) {
+        std::cout << m_nodes[cur].m_data << " ";
+    }
+    std::cout << std::endl;
+}
+
+// Function prints the elements of the list in ascending order.
+template <typename T, typename Compare>
+void CompactSortedList<T, Compare>::print_asc() const
+{
+    if (m_asc_head == kCompactNull) {
+        std::cout << "List is empty" << std::endl;
+        return;
+    }
+
+    for (uint32_t cur = m_asc_head; cur != kCompactNull; cur = m_nodes[cur].m_greater) {
+        std::cout << m_nodes[cur].m_data << " ";
+    }
+    std::cout << std::endl;
+}
+
+// Function prints the elements of the list in descending order.
+template <typename T, typename Compare>
+void CompactSortedList<T, Compare>::print_desc() const
+{
+    if (m_desc_head == kCompactNull) {
+        std::cout << "List is empty" << std::endl;
+        return;
+    }
+
+    for (uint32_t cur = m_desc_head; cur != kCompactNull; cur = m_nodes[cur].m_lesser) {
+        std::cout << m_nodes[cur].m_data << " ";
+    }
+    std::cout << std::endl;
+}
+
+/* Function creates a node holding the value and links it at the front or at the end of the
+   insertion order and into the sorted order */
+template <typename T, typename Compare>
+template <typename Value>
+void CompactSortedList<T, Compare>::emplace_node(bool front, Value&& value)
+{
+    const uint32_t elem = create_node(std::forward<Value>(value));
+
+    // Link into the insertion order
+    node_type& node = m_nodes[elem];
+    if (front) {
+        node.m_prev = kCompactNull;
+        node.m_next = m_head;
+        if (m_head != kCompactNull) {
+            m_nodes[m_head].m_prev = elem;
+        } else {
+            m_tail = elem;
+        }
+        m_head = elem;
+    } else {
+        node.m_prev = m_tail;
+        node.m_next = kCompactNull;
+        if (m_tail != kCompactNull) {
+            m_nodes[m_tail].m_next = elem;
+        } else {
+            m_head = elem;
+        }
+        m_tail = elem;
+    }
+
+    put_in_sorted_order(elem);
+    ++m_size;
+}
+
+// Function takes a node and a run of express lanes for it from the free lists, or appends them to the arrays.
+template <typename T, typename Compare>
+template <typename Value>
+uint32_t CompactSortedList<T, Compare>::create_node(Value&& value)
+{
+    // The arrays are indexed by 32 bits and kCompactNull is reserved
+    if (m_nodes.size() >= kCompactNull - 1 && m_free_nodes == kCompactNull) {
+        throw std::length_error("CompactSortedList cannot hold more elements");
+    }
+
+    // Take the lanes first, appending them cannot leave anything half done
+    const int level = random_level();
+    uint32_t lanes = kCompactNull;
+    if (level > 0) {
+        if (m_free_lanes[level - 1] != kCompactNull) {
+            lanes = m_free_lanes[level - 1];
+            m_free_lanes[level - 1] = m_lanes[lanes].m_greater;
+        } else {
+            lanes = static_cast<uint32_t>(m_lanes.size());
+            m_lanes.resize(m_lanes.size() + level);
+        }
+    }
+
+    uint32_t elem;
+    try {
+        if (m_free_nodes != kCompactNull) {
+            // Reuse a released node
+            elem = m_free_nodes;
+            m_nodes[elem].m_data = std::forward<Value>(value);
+            m_free_nodes = m_nodes[elem].m_next;
+        } else {
+            elem = static_cast<uint32_t>(m_nodes.size());
+            m_nodes.push_back(node_type{kCompactNull, kCompactNull, kCompactNull, kCompactNull, kCompactNull, 0, T(std::forward<Value>(value))});
+        }
+    } catch (...) {
+        // Give the lanes back if the value could not be stored
+        if (level > 0) {
+            m_lanes[lanes].m_greater = m_free_lanes[level - 1];
+            m_free_lanes[level - 1] = lanes;
+        }
+        throw;
+    }
+
+    m_nodes[elem].m_lanes = lanes;
+    m_nodes[elem].m_level = level;
+    return elem;
+}
+
+// Function puts a node and its lanes on the free lists, a value owning resources is reset to release them.
+template <typename T, typename Compare>
+void CompactSortedList<T, Compare>::destroy_node(uint32_t elem)
+{
+    node_type& node = m_nodes[elem];
+    if (node.m_level > 0) {
+        m_lanes[node.m_lanes].m_greater = m_free_lanes[node.m_level - 1];
+        m_free_lanes[node.m_level - 1] = node.m_lanes;
+    }
+
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+        node.m_data = T();
+    }
+
+    node.m_next = m_free_nodes;
+    m_free_nodes = elem;
+}
+
+// Function removes a node from both orders and releases it.
+template <typename T, typename Compare>
+void CompactSortedList<T, Compare>::erase_node(uint32_t elem)
+{
+    // Unlink from the insertion order
+    node_type& node = m_nodes[elem];
+    if (node.m_prev != kCompactNull) {
+        m_nodes[node.m_prev].m_next = node.m_next;
+    } else {
+        m_head = node.m_next;
+    }
+    if (node.m_next != kCompactNull) {
+        m_nodes[node.m_next].m_prev = node.m_prev;
+    } else {
+        m_tail = node.m_prev;
+    }
+
+    remove_sorted_node(elem);
+    destroy_node(elem);
+    --m_size;
+}
+
+// Function draws the number of express lanes of a new node, each further lane with probability 1/4.
+template <typename T, typename Compare>
+int CompactSortedList<T, Compare>::random_level()
+{
+    // xorshift32 step
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+
+    // Every pair of zero bits promotes the node one level higher
+    int level = 0;
+    unsigned int bits = m_seed;
+    while ((bits & 3u) == 0 && level < kMaxLevel) {
+        ++level;
+        bits >>= 2;
+    }
+    return level;
+}
+
+// Function links a node into the sorted chain and into each of its express lanes.
+template <typename T, typename Compare>
+void CompactSortedList<T, Compare>::put_in_sorted_order(uint32_t elem)
+{
+    const T& value = m_nodes[elem].m_data;
+
+    // A new maximum goes after m_desc_head, a new minimum before m_asc_head, otherwise search
+    uint32_t prev;
+    if (m_desc_head == kCompactNull || key_less(m_nodes[m_desc_head].m_data, value)) {
+        prev = m_desc_head;
+    } else if (!key_less(m_nodes[m_asc_head].m_data, value)) {
+        prev = kCompactNull;
+    } else {
+        prev = find_sorted_predecessor(value);
+    }
+
+    // The predecessor on level 'i' is the nearest node at or before the predecessor on level 'i - 1'
+    // that takes part in level 'i'
+    const int top = m_nodes[elem].m_level;
+    for (int level = 0; level <= top; ++level) {
+        while (prev != kCompactNull && m_nodes[prev].m_level < level) {
+            prev = lesser_link(prev, level - 1);
+        }
+
+        const uint32_t next = greater_link(prev, level);
+        greater_link(elem, level) = next;
+        lesser_link(elem, level) = prev;
+        greater_link(prev, level) = elem;
+        lesser_link(next, level) = elem;
+    }
+
+    // Raise the search level if the new node is the tallest one
+    if (top > m_level) {
+        m_level = top;
+    }
+}
+
+// Function unlinks a node from the sorted chain and from every express lane it takes part in.
+template <typename T, typename Compare>
+void CompactSortedList<T, Compare>::remove_sorted_node(uint32_t elem)
+{
+    const int top = m_nodes[elem].m_level;
+    for (int level = 0; level <= top; ++level) {
+        const uint32_t lesser = lesser_link(elem, level);
+        const uint32_t greater = greater_link(elem, level);
+        greater_link(lesser, level) = greater;
+        lesser_link(greater, level) = lesser;
+    }
+
+    // Lower the search level while the highest express lane is empty
+    while (m_level > 0 && m_lane_heads[m_level - 1].m_greater == kCompactNull) {
+        --m_level;
+    }
+}
+
+// Function returns the last node in sorted order less than the value, descending the express lanes.
+template <typename T, typename Compare>
+uint32_t CompactSortedList<T, Compare>::find_sorted_predecessor(const T& value) const
+{
+    uint32_t cur = kCompactNull;
+    for (int level = m_level; level >= 0; --level) {
+        uint32_t next = greater_link(cur, level);
+        while (next != kCompactNull && key_less(m_nodes[next].m_data, value)) {
+            cur = next;
+            next = greater_link(cur, level);
+        }
+    }
+    return cur;
+}
+
+// Function returns the last node in sorted order not greater than the value, descending the express lanes.
+template <typename T, typename Compare>
+uint32_t CompactSortedList<T, Compare>::find_sorted_last_not_greater(const T& value) const
+{
+    uint32_t cur = kCompactNull;
+    for (int level = m_level; level >= 0; --level) {
+        uint32_t next = greater_link(cur, level);
+        while (next != kCompactNull && !key_less(value, m_nodes[next].m_data)) {
+            cur = next;
+            next = greater_link(cur, level);
+        }
+    }
+    return cur;
+}
+
+// Function returns the 'greater' link of a node at the given level. kCompactNull stands for the
+// list itself, whose 'greater' link is the first node of that level.
+template <typename T, typename Compare>
+uint32_t& CompactSortedList<T, Compare>::greater_link(uint32_t elem, int level)
+{
+    if (elem == kCompactNull) {
+        return level == 0 ? m_asc_head : m_lane_heads[level - 1].m_greater;
+    }
+    return level == 0 ? m_nodes[elem].m_greater : m_lanes[m_nodes[elem].m_lanes + level - 1].m_greater;
+}
+
+template <typename T, typename Compare>
+uint32_t CompactSortedList<T, Compare>::greater_link(uint32_t elem, int level) const
+{
+    if (elem == kCompactNull) {
+        return level == 0 ? m_asc_head : m_lane_heads[level - 1].m_greater;
+    }
+    return level == 0 ? m_nodes[elem].m_greater : m_lanes[m_nodes[elem].m_lanes + level - 1].m_greater;
+}
+
+// Function returns the 'lesser' link of a node at the given level. kCompactNull stands for the
+// list itself, whose 'lesser' link is the last node of that level.
+template <typename T, typename Compare>
+uint32_t& CompactSortedList<T, Compare>::lesser_link(uint32_t elem, int level)
+{
+    if (elem == kCompactNull) {
+        return level == 0 ? m_desc_head : m_lane_heads[level - 1].m_lesser;
+    }
+    return level == 0 ? m_nodes[elem].m_lesser : m_lanes[m_nodes[elem].m_lanes + level - 1].m_lesser;
+}
+
+// Function checks whether 'lhs' is ordered before 'rhs'.
+template <typename T, typename Compare>
+bool CompactSortedList<T, Compare>::key_less(const T& lhs, const T& rhs) const
+{
+    return m_compare(lhs, rhs);
+}
+
+#endif // COMPACT_SORTED_LIST_IMPL_HPP_
@@ -0,0 +1,53 @@
+#ifndef CONCURRENT_NODE_HPP_
+#define CONCURRENT_NODE_HPP_
+
+#include <atomic>
+#include <utility>
+
+template <typename T>
+struct ConcurrentNode;
+
+// Links of a concurrent node on one express lane above the sorted chain
+template <typename T>
+struct ConcurrentLane
+{
+    std::atomic<ConcurrentNode<T>*> m_greater; // Followed by readers
+    ConcurrentNode<T>* m_lesser; // Used by the writer only
+};
+
+/* Node of ConcurrentSortedList. The forward links (m_next, m_greater and the 'greater' link of every
+   lane) are atomic, since readers follow them without a lock. The backward links are only touched by
+   the writer. A node is never changed after it is unlinked, so a reader standing on it can continue. */
+template <typename T>
+struct ConcurrentNode
+{
+    template <typename Value>
+    ConcurrentNode(Value&& data, int level)
+        : m_next(nullptr)
+        , m_prev(nullptr)
+        , m_greater(nullptr)
+        , m_lesser(nullptr)
+        , m_lanes(level > 0 ? new ConcurrentLane<T>[level] : nullptr)
+        , m_level(level)
+        , m_data(std::forward<Value>(data))
+    {
+    }
+
+    ConcurrentNode(const ConcurrentNode<T>& other) = delete;
+    ConcurrentNode<T>& operator=(const ConcurrentNode<T>& other) = delete;
+
+    ~ConcurrentNode()
+    {
+        delete[] m_lanes;
+    }
+
+    std::atomic<ConcurrentNode<T>*> m_next;
+    ConcurrentNode<T>* m_prev;
+    std::atomic<ConcurrentNode<T>*> m_greater;
+    ConcurrentNode<T>* m_lesser;
+    ConcurrentLane<T>* m_lanes; // Express lanes, m_lanes[i] is level i + 1
+    int m_level; // Number of express lanes the node takes part in
+    T m_data;
+};
+
+#endif // CONCURRENT_NODE_HPP_
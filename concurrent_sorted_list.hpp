@@ -0,0 +1,96 @@
+#ifndef CONCURRENT_SORTED_LIST_HPP_
+#define CONCURRENT_SORTED_LIST_HPP_
+
+#include "concurrent_node.hpp"
+#include "epoch_reclaimer.hpp"
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <mutex>
+
+/* Sorted list keeping the insertion order and the sorted order like SelfOrganizingSortedList, shared
+   between threads. Readers walk both orders and descend the express lanes without taking a lock,
+   following atomic forward links. Writers are serialized by a mutex. Unlinked nodes are handed to an
+   epoch reclaimer, which deletes them once no reader can stand on them.
+   A reader sees every change completed before it started, changes made during its walk may or may
+   not be seen. Values are passed to the callbacks by reference and must not be kept after they return. */
+template <typename T, typename Compare = std::less<>>
+class ConcurrentSortedList
+{
+public:
+    using value_type = T;
+    using key_compare = Compare;
+    using node_type = ConcurrentNode<T>;
+
+public:
+    ConcurrentSortedList(); // Default constructor
+    explicit ConcurrentSortedList(const Compare& compare); // Constructor with a comparator
+    ConcurrentSortedList(std::initializer_list<T> init_list); // Constructor with initializer list
+
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    ConcurrentSortedList(InputIt first, InputIt last); // Constructor with a range of values
+
+    ConcurrentSortedList(const ConcurrentSortedList<T, Compare>& other) = delete;
+    ConcurrentSortedList<T, Compare>& operator=(const ConcurrentSortedList<T, Compare>& other) = delete;
+
+    ~ConcurrentSortedList(); // Destructor, no other thread may use the list any more
+
+public:
+    // Modifiers, serialized by the writer mutex
+    void push_back(const T& value); // Adds an element to the end
+    void push_front(const T& value); // Inserts an element to the beginning
+    void pop_back(); // Removes the last element
+    void pop_front(); // Removes the first element
+    void remove(const T& value); // Removes all equal elements
+    bool remove_one(const T& value); // Removes the first equal element in sorted order
+    void clear(); // Clears the contents
+
+    // Lookup, lock-free
+    bool contains(const T& value) const; // Checks whether an equal element exists
+    int count(const T& value) const; // Returns the number of equal elements
+
+    // Traversals, lock-free
+    template <typename Function>
+    void for_each(Function&& function) const; // Calls function on every element in insertion order
+    template <typename Function>
+    void for_each_sorted(Function&& function) const; // Calls function on every element in ascending order
+    template <typename Function>
+    void for_each_in_range(const T& low, const T& high, Function&& function) const; // Ascending elements in [low, high)
+
+    // Capacity
+    bool empty() const; // Checks whether the container is empty
+    int size() const; // Returns the number of elements
+
+private:
+    template <typename Value>
+    void emplace_node(bool front, Value&& value); // Creates a node and publishes it in both orders
+    void erase_node(node_type* elem); // Unlinks a node from both orders and retires it
+    int random_level(); // Draws the number of express lanes for a new node
+
+    void put_in_sorted_order(node_type* elem); // Publishes a node in the sorted chain and its lanes
+    void remove_sorted_node(node_type* elem); // Unlinks a node from the sorted chain and its lanes
+    node_type* find_sorted_lower_bound(const T& value) const; // First node not less than value
+    node_type* find_sorted_last_not_greater(const T& value) const; // Last node not greater than value
+    std::atomic<node_type*>& greater_link(node_type* elem, int level) const; // nullptr elem is the list head
+    node_type*& lesser_link(node_type* elem, int level); // nullptr elem is the list head
+    bool key_less(const T& lhs, const T& rhs) const; // Checks whether lhs is ordered before rhs
+
+private:
+    static constexpr int kMaxLevel = 16; // Supports about 4^16 elements with p = 1/4
+
+    std::atomic<node_type*> m_head;
+    node_type* m_tail; // Writer only
+    mutable std::atomic<node_type*> m_lane_heads[kMaxLevel + 1]; // First node of the sorted chain (0) and of every express lane
+    node_type* m_lane_tails[kMaxLevel + 1]; // Last node of the sorted chain (0) and of every express lane, writer only
+    std::atomic<int> m_size;
+    std::atomic<int> m_level; // Highest express lane in use
+    unsigned int m_seed; // State of the level generator, writer only
+    std::mutex m_writer; // Serializes the modifiers
+    EpochReclaimer<node_type> m_reclaimer; // Deletes unlinked nodes
+    Compare m_compare; // Orders the elements
+};
+
+#include "concurrent_sorted_list_impl_.hpp"
+
+#endif // CONCURRENT_SORTED_LIST_HPP_
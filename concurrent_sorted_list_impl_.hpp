@@ -0,0 +1,424 @@
+#ifndef CONCURRENT_SORTED_LIST_IMPL_HPP_
+#define CONCURRENT_SORTED_LIST_IMPL_HPP_
+
+#include <stdexcept>
+#include <utility>
+
+// Default constructor
+template <typename T, typename Compare>
+ConcurrentSortedList<T, Compare>::ConcurrentSortedList()
+    : ConcurrentSortedList(Compare())
+{
+}
+
+// Constructor with a comparator
+template <typename T, typename Compare>
+ConcurrentSortedList<T, Compare>::ConcurrentSortedList(const Compare& compare)
+    : m_head(nullptr)
+    , m_tail(nullptr)
+    , m_lane_heads()
+    , m_lane_tails()
+    , m_size(0)
+    , m_level(0)
+    , m_seed(0x9E3779B9u)
+    , m_writer()
+    , m_reclaimer()
+    , m_compare(compare)
+{
+    for (int i = 0; i <= kMaxLevel; ++i) {
+        m_lane_heads[i].store(nullptr, std::memory_order_relaxed);
+        m_lane_tails[i] = nullptr;
+    }
+}
+
+// Constructor with initializer list
+template <typename T, typename Compare>
+ConcurrentSortedList<T, Compare>::ConcurrentSortedList(std::initializer_list<T> init_list)
+    : ConcurrentSortedList(init_list.begin(), init_list.end())
+{
+}
+
+// Constructor with a range of values
+template <typename T, typename Compare>
+template <typename InputIt, typename>
+ConcurrentSortedList<T, Compare>::ConcurrentSortedList(InputIt first, InputIt last)
+    : ConcurrentSortedList()
+{
+    for (; first != last; ++first) {
+        push_back(*first);
+    }
+}
+
+// Destructor
+template <typename T, typename Compare>
+ConcurrentSortedList<T, Compare>::~ConcurrentSortedList()
+{
+    // The nodes still linked are deleted here, the retired ones by the reclaimer
+    node_type* cur = m_head.load(std::memory_order_relaxed);
+    while (cur) {
+        node_type* next = cur->m_next.load(std::memory_order_relaxed);
+        delete cur;
+        cur = next;
+    }
+}
+
+// Adds a new node with the given value to the end of the list
+template <typename T, typename Compare>
+void ConcurrentSortedList<T, Compare>::push_back(const T& value)
+{
+    emplace_node(false, value);
+}
+
+// Adds a new node with the given value to the front of the list
+template <typename T, typename Compare>
+void ConcurrentSortedList<T, Compare>::push_front(const T& value)
+{
+    emplace_node(true, value);
+}
+
+// Removes the last element in insertion order.
+template <typename T, typename Compare>
+void ConcurrentSortedList<T, Compare>::pop_back()
+{
+    std::lock_guard<std::mutex> lock(m_writer);
+
+    // Check if the list is empty
+    if (!m_tail) {
+        throw std::runtime_error("List is empty. Cannot pop_back()");
+    }
+
+    erase_node(m_tail);
+}
+
+// Removes the first element in insertion order.
+template <typename T, typename Compare>
+void ConcurrentSortedList<T, Compare>::pop_front()
+{
+    std::lock_guard<std::mutex> lock(m_writer);
+
+    // Check if the list is empty
+    node_type* head = m_head.load(std::memory_order_relaxed);
+    if (!head) {
+        throw std::runtime_error("List is empty. Cannot pop_front()");
+    }
+
+    erase_node(head);
+}
+
+// Function removes all elements equal to the given value, which form one run of the sorted chain.
+template <typename T, typename Compare>
+void ConcurrentSortedList<T, Compare>::remove(const T& value)
+{
+    std::lock_guard<std::mutex> lock(m_writer);
+
+    node_type* cur = find_sorted_lower_bound(value);
+    while (cur && !key_less(value, cur->m_data)) {
+        // The links of a retired node stay intact, but read the next one first anyway
+        node_type* next = cur->m_greater.load(std::memory_order_relaxed);
+        erase_node(cur);
+        cur = next;
+    }
+}
+
+// Function removes the first element equal to the given value in sorted order, returns whether one was found.
+template <typename T, typename Compare>
+bool ConcurrentSortedList<T, Compare>::remove_one(const T& value)
+{
+    std::lock_guard<std::mutex> lock(m_writer);
+
+    node_type* elem = find_sorted_lower_bound(value);
+    if (!elem || key_less(value, elem->m_data)) {
+        return false;
+    }
+
+    erase_node(elem);
+    return true;
+}
+
+// Function unlinks every element at once and retires them.
+template <typename T, typename Compare>
+void ConcurrentSortedList<T, Compare>::clear()
+{
+    std::lock_guard<std::mutex> lock(m_writer);
+
+    node_type* cur = m_head.load(std::memory_order_relaxed);
+
+    // Readers starting from now on find an empty list
+    m_head.store(nullptr, std::memory_order_release);
+    m_tail = nullptr;
+    for (int i = 0; i <= kMaxLevel; ++i) {
+        m_lane_heads[i].store(nullptr, std::memory_order_release);
+        m_lane_tails[i] = nullptr;
+    }
+    m_level.store(0, std::memory_order_relaxed);
+    m_size.store(0, std::memory_order_relaxed);
+
+    while (cur) {
+        node_type* next = cur->m_next.load(std::memory_order_relaxed);
+        m_reclaimer.retire(cur);
+        cur = next;
+    }
+}
+
+// Function checks whether an element equal to the value exists.
+template <typename T, typename Compare>
+bool ConcurrentSortedList<T, Compare>::contains(const T& value) const
+{
+    typename EpochReclaimer<node_type>::ReadGuard guard(m_reclaimer);
+
+    const node_type* elem = find_sorted_lower_bound(value);
+    return elem && !key_less(value, elem->m_data);
+}
+
+// Function returns the number of elements equal to the value.
+template <typename T, typename Compare>
+int ConcurrentSortedList<T, Compare>::count(const T& value) const
+{
+    typename EpochReclaimer<node_type>::ReadGuard guard(m_reclaimer);
+
+    int result = 0;
+    const node_type* cur = find_sorted_lower_bound(value);
+    while (cur && !key_less(value, cur->m_data)) {
+        ++result;
+        cur = cur->m_greater.load(std::memory_order_acquire);
+    }
+    return result;
+}
+
+// Function calls 'function' on every element in insertion order.
+template <typename T, typename Compare>
+template <typename Function>
+void ConcurrentSortedList<T, Compare>::for_each(Function&& function) const
+{
+    typename EpochReclaimer<node_type>::ReadGuard guard(m_reclaimer);
+
+    for (const node_type* cur = m_head.load(std::memory_order_acquire); cur; cur = cur->m_next.load(std::memory_order_acquire)) {
+        function(cur->m_data);
+    }
+}
+
+// Function calls 'function' on every element in ascending order.
+template <typename T, typename Compare>
+template <typename Function>
+void ConcurrentSortedList<T, Compare>::for_each_sorted(Function&& function) const
+{
+    typename EpochReclaimer<node_type>::ReadGuard guard(m_reclaimer);
+
+    for (const node_type* cur = m_lane_heads[0].load(std::memory_order_acquire); cur; cur = cur->m_greater.load(std::memory_order_acquire)) {
+        function(cur->m_data);
+    }
+}
+
+// Function calls 'function' in ascending order on every element not less than 'low' and less than 'high'.
+template <typename T, typename Compare>
+template <typename Function>
+void ConcurrentSortedList<T, Compare>::for_each_in_range(const T& low, const T& high, Function&& function) const
+{
+    typename EpochReclaimer<node_type>::ReadGuard guard(m_reclaimer);
+
+    const node_type* cur = find_sorted_lower_bound(low);
+    while (cur && key_less(cur->m_data, high)) {
+        function(cur->m_data);
+        cur = cur->m_greater.load(std::memory_order_acquire);
+    }
+}
+
+// Checks if the list is empty.
+template <typename T, typename Compare>
+bool ConcurrentSortedList<T, Compare>::empty() const
+{
+    return size() == 0;
+}
+
+// Return the number of elements.
+template <typename T, typename Compare>
+int ConcurrentSortedList<T, Compare>::size() const
+{
+    return m_size.load(std::memory_order_relaxed);
+}
+
+/* Function creates a node holding the value, completes its own links and then publishes it at the
+   front or at the end of the insertion order and in the sorted order */
+template <typename T, typename Compare>
+template <typename Value>
+void ConcurrentSortedList<T, Compare>::emplace_node(bool front, Value&& value)
+{
+    std::lock_guard<std::mutex> lock(m_writer);
+
+    node_type* elem = new node_type(std::forward<Value>(value), random_level());
+
+    // Publish in the insertion order
+    node_type* head = m_head.load(std::memory_order_relaxed);
+    if (front) {
+        elem->m_next.store(head, std::memory_order_relaxed);
+        if (head) {
+            head->m_prev = elem;
+        } else {
+            m_tail = elem;
+        }
+        m_head.store(elem, std::memory_order_release);
+    } else {
+        elem->m_prev = m_tail;
+        if (m_tail) {
+            m_tail->m_next.store(elem, std::memory_order_release);
+        } else {
+            m_head.store(elem, std::memory_order_release);
+        }
+        m_tail = elem;
+    }
+
+    put_in_sorted_order(elem);
+    m_size.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Function unlinks a node from both orders and hands it to the reclaimer.
+template <typename T, typename Compare>
+void ConcurrentSortedList<T, Compare>::erase_node(node_type* elem)
+{
+    // Unlink from the insertion order, the node keeps its own links for readers standing on it
+    node_type* next = elem->m_next.load(std::memory_order_relaxed);
+    if (elem->m_prev) {
+        elem->m_prev->m_next.store(next, std::memory_order_release);
+    } else {
+        m_head.store(next, std::memory_order_release);
+    }
+    if (next) {
+        next->m_prev = elem->m_prev;
+    } else {
+        m_tail = elem->m_prev;
+    }
+
+    remove_sorted_node(elem);
+    m_size.fetch_sub(1, std::memory_order_relaxed);
+    m_reclaimer.retire(elem);
+}
+
+// Function draws the number of express lanes of a new node, each further lane with probability 1/4.
+template <typename T, typename Compare>
+int ConcurrentSortedList<T, Compare>::random_level()
+{
+    // xorshift32 step
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+
+    // Every pair of zero bits promotes the node one level higher
+    int level = 0;
+    unsigned int bits = m_seed;
+    while ((bits & 3u) == 0 && level < kMaxLevel) {
+        ++level;
+        bits >>= 2;
+    }
+    return level;
+}
+
+/* Function links a node into the sorted chain and into each of its express lanes, after the
+   elements equal to it. Every level is published bottom-up and only after the node's own link on
+   that level is set, so a reader reaching the node finds all links below complete. */
+template <typename T, typename Compare>
+void ConcurrentSortedList<T, Compare>::put_in_sorted_order(node_type* elem)
+{
+    node_type* prev = find_sorted_last_not_greater(elem->m_data);
+
+    // The predecessor on level 'i' is the nearest node at or before the predecessor on level 'i - 1'
+    // that takes part in level 'i'
+    for (int level = 0; level <= elem->m_level; ++level) {
+        while (prev && prev->m_level < level) {
+            prev = lesser_link(prev, level - 1);
+        }
+
+        node_type* next = greater_link(prev, level).load(std::memory_order_relaxed);
+        greater_link(elem, level).store(next, std::memory_order_relaxed);
+        lesser_link(elem, level) = prev;
+        lesser_link(next, level) = elem;
+        greater_link(prev, level).store(elem, std::memory_order_release);
+    }
+
+    // Raise the search level if the new node is the tallest one
+    if (elem->m_level > m_level.load(std::memory_order_relaxed)) {
+        m_level.store(elem->m_level, std::memory_order_release);
+    }
+}
+
+// Function unlinks a node from the sorted chain and from every express lane it takes part in.
+template <typename T, typename Compare>
+void ConcurrentSortedList<T, Compare>::remove_sorted_node(node_type* elem)
+{
+    for (int level = elem->m_level; level >= 0; --level) {
+        node_type* lesser = lesser_link(elem, level);
+        node_type* greater = greater_link(elem, level).load(std::memory_order_relaxed);
+        greater_link(lesser, level).store(greater, std::memory_order_release);
+        lesser_link(greater, level) = lesser;
+    }
+
+    // Lower the search level while the highest express lane is empty
+    int top = m_level.load(std::memory_order_relaxed);
+    while (top > 0 && !m_lane_heads[top].load(std::memory_order_relaxed)) {
+        --top;
+    }
+    m_level.store(top, std::memory_order_release);
+}
+
+/* Function returns the first node in sorted order not less than the value, descending the express lanes.
+   The result is the successor the search compared against on the sorted chain. Loading the link of the
+   predecessor once more could return a node a writer inserted in between, which may be less than the value. */
+template <typename T, typename Compare>
+typename ConcurrentSortedList<T, Compare>::node_type* ConcurrentSortedList<T, Compare>::find_sorted_lower_bound(const T& value) const
+{
+    node_type* cur = nullptr;
+    node_type* next = nullptr;
+    for (int level = m_level.load(std::memory_order_acquire); level >= 0; --level) {
+        next = greater_link(cur, level).load(std::memory_order_acquire);
+        while (next && key_less(next->m_data, value)) {
+            cur = next;
+            next = greater_link(cur, level).load(std::memory_order_acquire);
+        }
+    }
+    return next;
+}
+
+// Function returns the last node in sorted order not greater than the value, descending the express lanes.
+template <typename T, typename Compare>
+typename ConcurrentSortedList<T, Compare>::node_type* ConcurrentSortedList<T, Compare>::find_sorted_last_not_greater(const T& value) const
+{
+    node_type* cur = nullptr;
+    for (int level = m_level.load(std::memory_order_acquire); level >= 0; --level) {
+        node_type* next = greater_link(cur, level).load(std::memory_order_acquire);
+        while (next && !key_less(value, next->m_data)) {
+            cur = next;
+            next = greater_link(cur, level).load(std::memory_order_acquire);
+        }
+    }
+    return cur;
+}
+
+// Function returns the 'greater' link of a node at the given level. nullptr stands for the list
+// itself, whose 'greater' link is the first node of that level.
+template <typename T, typename Compare>
+std::atomic<typename ConcurrentSortedList<T, Compare>::node_type*>& ConcurrentSortedList<T, Compare>::greater_link(node_type* elem, int level) const
+{
+    if (!elem) {
+        return m_lane_heads[level];
+    }
+    return level == 0 ? elem->m_greater : elem->m_lanes[level - 1].m_greater;
+}
+
+// Function returns the 'lesser' link of a node at the given level. nullptr stands for the list
+// itself, whose 'lesser' link is the last node of that level.
+template <typename T, typename Compare>
+typename ConcurrentSortedList<T, Compare>::node_type*& ConcurrentSortedList<T, Compare>::lesser_link(node_type* elem, int level)
+{
+    if (!elem) {
+        return m_lane_tails[level];
+    }
+    return level == 0 ? elem->m_lesser : elem->m_lanes[level - 1].m_lesser;
+}
+
+// Function checks whether 'lhs' is ordered before 'rhs'.
+template <typename T, typename Compare>
+bool ConcurrentSortedList<T, Compare>::key_less(const T& lhs, const T& rhs) const
+{
+    return m_compare(lhs, rhs);
+}
+
+#endif // CONCURRENT_SORTED_LIST_IMPL_HPP_
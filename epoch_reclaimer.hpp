@@ -0,0 +1,67 @@
+#ifndef EPOCH_RECLAIMER_HPP_
+#define EPOCH_RECLAIMER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/* Epoch-based reclamation of nodes unlinked from a structure that is read without locks.
+   A reader announces the global epoch in a slot while it traverses. A retired node is stamped
+   with the epoch of its retirement and deleted once every announced epoch is newer, since a
+   reader that announced a newer epoch started after the node had been unlinked.
+   retire() and collect() must be called by one writer at a time. */
+template <typename Node>
+class EpochReclaimer
+{
+public:
+    static constexpr int kMaxReaders = 64; // Readers inside a traversal at the same time
+    static constexpr size_t kCollectThreshold = 64; // Retired nodes that trigger a collection
+
+    // Keeps the calling thread announced for its lifetime
+    class ReadGuard
+    {
+    public:
+        explicit ReadGuard(const EpochReclaimer<Node>& reclaimer);
+        ~ReadGuard();
+
+        ReadGuard(const ReadGuard& other) = delete;
+        ReadGuard& operator=(const ReadGuard& other) = delete;
+
+    private:
+        const EpochReclaimer<Node>& m_reclaimer;
+        int m_slot;
+    };
+
+public:
+    EpochReclaimer(); // Default constructor
+    ~EpochReclaimer(); // Deletes every retired node, no reader may be active
+
+    EpochReclaimer(const EpochReclaimer<Node>& other) = delete;
+    EpochReclaimer<Node>& operator=(const EpochReclaimer<Node>& other) = delete;
+
+public:
+    void retire(Node* node); // Deletes the node once no reader can reach it
+    void collect(); // Deletes the retired nodes no reader can reach any more
+    size_t pending() const; // Returns the number of retired nodes not deleted yet
+
+private:
+    int enter() const; // Announces the current epoch in a free slot
+    void leave(int slot) const; // Clears the slot
+
+private:
+    // One cache line per slot so that readers do not share lines
+    struct alignas(64) ReaderSlot
+    {
+        std::atomic<uint64_t> m_epoch; // Announced epoch, 0 when idle
+    };
+
+    mutable ReaderSlot m_slots[kMaxReaders];
+    std::atomic<uint64_t> m_epoch; // Global epoch, starts at 1
+    std::vector<std::pair<uint64_t, Node*>> m_retired; // Retired nodes with their retirement epoch
+};
+
+#include "epoch_reclaimer_impl_.hpp"
+
+#endif // EPOCH_RECLAIMER_HPP_
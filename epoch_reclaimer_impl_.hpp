@@ -0,0 +1,119 @@
+#ifndef EPOCH_RECLAIMER_IMPL_HPP_
+#define EPOCH_RECLAIMER_IMPL_HPP_
+
+#include <functional>
+#include <limits>
+#include <thread>
+
+// Announces the calling thread as a reader.
+template <typename Node>
+EpochReclaimer<Node>::ReadGuard::ReadGuard(const EpochReclaimer<Node>& reclaimer)
+    : m_reclaimer(reclaimer)
+    , m_slot(reclaimer.enter())
+{
+}
+
+// Clears the announcement.
+template <typename Node>
+EpochReclaimer<Node>::ReadGuard::~ReadGuard()
+{
+    m_reclaimer.leave(m_slot);
+}
+
+// Default constructor
+template <typename Node>
+EpochReclaimer<Node>::EpochReclaimer()
+    : m_slots()
+    , m_epoch(1)
+    , m_retired()
+{
+    for (int i = 0; i < kMaxReaders; ++i) {
+        m_slots[i].m_epoch.store(0, std::memory_order_relaxed);
+    }
+}
+
+// Destructor
+template <typename Node>
+EpochReclaimer<Node>::~EpochReclaimer()
+{
+    for (const std::pair<uint64_t, Node*>& retired : m_retired) {
+        delete retired.second;
+    }
+}
+
+/* Function stamps an unlinked node with the current epoch and advances the epoch, so readers
+   starting from now on announce a newer one. */
+template <typename Node>
+void EpochReclaimer<Node>::retire(Node* node)
+{
+    m_retired.emplace_back(m_epoch.fetch_add(1), node);
+    if (m_retired.size() >= kCollectThreshold) {
+        collect();
+    }
+}
+
+// Function deletes the retired nodes whose epoch is older than the oldest announced one.
+template <typename Node>
+void EpochReclaimer<Node>::collect()
+{
+    // Pairs with the fence of enter(): either the reader is seen here, or it sees the unlinking
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    uint64_t oldest = std::numeric_limits<uint64_t>::max();
+    for (int i = 0; i < kMaxReaders; ++i) {
+        const uint64_t epoch = m_slots[i].m_epoch.load(std::memory_order_acquire);
+        if (epoch != 0 && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+
+    // Keep the nodes a reader may still stand on, in their retirement order
+    size_t kept = 0;
+    for (size_t i = 0; i < m_retired.size(); ++i) {
+        if (m_retired[i].first < oldest) {
+            delete m_retired[i].second;
+        } else {
+            m_retired[kept++] = m_retired[i];
+        }
+    }
+    m_retired.resize(kept);
+}
+
+// Return the number of retired nodes that are not deleted yet.
+template <typename Node>
+size_t EpochReclaimer<Node>::pending() const
+{
+    return m_retired.size();
+}
+
+/* Function claims a free slot, starting at one picked by the thread id so that threads rarely
+   compete for a slot, and announces the current epoch in it. */
+template <typename Node>
+int EpochReclaimer<Node>::enter() const
+{
+    const size_t start = std::hash<std::thread::id>()(std::this_thread::get_id());
+    for (;;) {
+        for (int i = 0; i < kMaxReaders; ++i) {
+            ReaderSlot& slot = m_slots[(start + i) % kMaxReaders];
+            uint64_t idle = 0;
+            if (slot.m_epoch.load(std::memory_order_relaxed) == 0
+                && slot.m_epoch.compare_exchange_strong(idle, m_epoch.load(std::memory_order_acquire))) {
+                // The announcement must be visible before the traversal reads any link
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                return static_cast<int>((start + i) % kMaxReaders);
+            }
+        }
+
+        // All slots are taken, wait for a reader to leave
+        std::this_thread::yield();
+    }
+}
+
+// Function clears the announcement of a slot.
+template <typename Node>
+void EpochReclaimer<Node>::leave(int slot) const
+{
+    m_slots[slot].m_epoch.store(0, std::memory_order_release);
+}
+
+#endif // EPOCH_RECLAIMER_IMPL_HPP_
@@ -0,0 +1,92 @@
+#ifndef LIST_STATS_HPP_
+#define LIST_STATS_HPP_
+
+#include <atomic>
+#include <cstdint>
+
+/* Counters of the work done by a SelfOrganizingSortedList, compiled in only when SOSL_ENABLE_STATS is
+   defined. Without it SOSL_STATS() drops its argument, so the list carries neither the counters nor
+   the code updating them. */
+#ifdef SOSL_ENABLE_STATS
+#define SOSL_STATS(...) __VA_ARGS__
+#else
+#define SOSL_STATS(...)
+#endif
+
+// Histogram of lengths on a log2 scale: bucket 0 counts zero, bucket k counts [2^(k-1), 2^k)
+struct LengthHistogram
+{
+    static constexpr int kBuckets = 33; // Bucket 32 holds every length of 2^31 or more
+
+    uint64_t m_counts[kBuckets] = {};
+
+    void record(uint64_t length); // Counts one length
+    static int bucket_of(uint64_t length); // Bucket a length falls into
+    static uint64_t bucket_floor(int bucket); // Shortest length of a bucket
+};
+
+struct ListStats
+{
+    // Sorted searches, one per insertion into the sorted order and per lower_bound/upper_bound
+    uint64_t m_sorted_searches = 0;
+    uint64_t m_comparisons = 0; // Key comparisons made by the searches
+    uint64_t m_hops = 0; // Sorted links followed by the searches, on the chain and on the express lanes
+    LengthHistogram m_search_hops; // Hops per search
+
+    // Positional walks, one per position looked up by insert(), erase() and element access
+    uint64_t m_positional_walks = 0;
+    uint64_t m_walk_steps = 0; // Insertion links followed by the walks
+    LengthHistogram m_walk_lengths; // Steps per walk
+
+    // Nodes
+    uint64_t m_allocations = 0; // Nodes created
+    uint64_t m_frees = 0; // Nodes released
+
+    double comparisons_per_search() const; // Average key comparisons of a sorted search
+    double hops_per_search() const; // Average links followed by a sorted search
+    double steps_per_walk() const; // Average links followed by a positional walk
+};
+
+// Work of one sorted search, kept in the searching thread and recorded once the search is done
+struct SearchCost
+{
+#ifdef SOSL_ENABLE_STATS
+    uint64_t m_comparisons = 0;
+    uint64_t m_hops = 0;
+#endif
+};
+
+/* Counters behind ListStats. They are relaxed atomics, so const lookups running on several threads
+   can record into them without a lock. */
+class StatsCounters
+{
+public:
+    StatsCounters() = default;
+    StatsCounters(const StatsCounters& other) = delete;
+    StatsCounters& operator=(const StatsCounters& other) = delete;
+
+public:
+    void record_search(const SearchCost& cost); // Counts one sorted search
+    void record_walk(uint64_t steps); // Counts one positional walk
+    void record_allocations(uint64_t nodes); // Counts created nodes
+    void record_frees(uint64_t nodes); // Counts released nodes
+    void transfer_allocations(StatsCounters& from, uint64_t nodes); // Takes over the allocations of nodes moved from another list
+
+    ListStats snapshot() const; // Current values of the counters
+    void reset(); // Zeroes the counters
+
+private:
+    std::atomic<uint64_t> m_sorted_searches{0};
+    std::atomic<uint64_t> m_comparisons{0};
+    std::atomic<uint64_t> m_hops{0};
+    std::atomic<uint64_t> m_search_hops[LengthHistogram::kBuckets] = {};
+    std::atomic<uint64_t> m_positional_walks{0};
+    std::atomic<uint64_t> m_walk_steps{0};
+    std::atomic<uint64_t> m_walk_lengths[LengthHistogram::kBuckets] = {};
+    std::atomic<uint64_t> m_allocations{0};
+    std::atomic<uint64_t> m_frees{0};
+};
+
+#include "list_stats_impl_.hpp"
+
+#endif // LIST_STATS_HPP_
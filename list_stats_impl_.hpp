@@ -0,0 +1,122 @@
+#ifndef LIST_STATS_IMPL_HPP_
+#define LIST_STATS_IMPL_HPP_
+
+// Function adds one length to its bucket.
+inline void LengthHistogram::record(uint64_t length)
+{
+    ++m_counts[bucket_of(length)];
+}
+
+// Function returns the bucket of a length: 0 for zero, otherwise one more than the index of its highest set bit.
+inline int LengthHistogram::bucket_of(uint64_t length)
+{
+    int bucket = 0;
+    while (length != 0 && bucket < kBuckets - 1) {
+        ++bucket;
+        length >>= 1;
+    }
+    return bucket;
+}
+
+// Function returns the shortest length counted by a bucket.
+inline uint64_t LengthHistogram::bucket_floor(int bucket)
+{
+    return bucket == 0 ? 0 : uint64_t(1) << (bucket - 1);
+}
+
+// Return the average number of key comparisons of a sorted search.
+inline double ListStats::comparisons_per_search() const
+{
+    return m_sorted_searches == 0 ? 0.0 : static_cast<double>(m_comparisons) / static_cast<double>(m_sorted_searches);
+}
+
+// Return the average number of links followed by a sorted search.
+inline double ListStats::hops_per_search() const
+{
+    return m_sorted_searches == 0 ? 0.0 : static_cast<double>(m_hops) / static_cast<double>(m_sorted_searches);
+}
+
+// Return the average number of links followed by a positional walk.
+inline double ListStats::steps_per_walk() const
+{
+    return m_positional_walks == 0 ? 0.0 : static_cast<double>(m_walk_steps) / static_cast<double>(m_positional_walks);
+}
+
+// Function adds the work of one sorted search.
+inline void StatsCounters::record_search(const SearchCost& cost)
+{
+#ifdef SOSL_ENABLE_STATS
+    m_sorted_searches.fetch_add(1, std::memory_order_relaxed);
+    m_comparisons.fetch_add(cost.m_comparisons, std::memory_order_relaxed);
+    m_hops.fetch_add(cost.m_hops, std::memory_order_relaxed);
+    m_search_hops[LengthHistogram::bucket_of(cost.m_hops)].fetch_add(1, std::memory_order_relaxed);
+#else
+    (void)cost;
+#endif
+}
+
+// Function adds one positional walk of 'steps' links.
+inline void StatsCounters::record_walk(uint64_t steps)
+{
+    m_positional_walks.fetch_add(1, std::memory_order_relaxed);
+    m_walk_steps.fetch_add(steps, std::memory_order_relaxed);
+    m_walk_lengths[LengthHistogram::bucket_of(steps)].fetch_add(1, std::memory_order_relaxed);
+}
+
+// Function adds created nodes.
+inline void StatsCounters::record_allocations(uint64_t nodes)
+{
+    m_allocations.fetch_add(nodes, std::memory_order_relaxed);
+}
+
+// Function adds released nodes.
+inline void StatsCounters::record_frees(uint64_t nodes)
+{
+    m_frees.fetch_add(nodes, std::memory_order_relaxed);
+}
+
+/* Function moves the allocations of nodes handed over by another list to this one, so each list keeps
+   allocations minus frees equal to the nodes it owns. The other list gives up no more than it counted,
+   it may have been reset since the nodes were created. */
+inline void StatsCounters::transfer_allocations(StatsCounters& from, uint64_t nodes)
+{
+    const uint64_t counted = from.m_allocations.load(std::memory_order_relaxed);
+    from.m_allocations.store(counted - (nodes < counted ? nodes : counted), std::memory_order_relaxed);
+    m_allocations.fetch_add(nodes, std::memory_order_relaxed);
+}
+
+// Function copies the counters into a ListStats.
+inline ListStats StatsCounters::snapshot() const
+{
+    ListStats stats;
+    stats.m_sorted_searches = m_sorted_searches.load(std::memory_order_relaxed);
+    stats.m_comparisons = m_comparisons.load(std::memory_order_relaxed);
+    stats.m_hops = m_hops.load(std::memory_order_relaxed);
+    stats.m_positional_walks = m_positional_walks.load(std::memory_order_relaxed);
+    stats.m_walk_steps = m_walk_steps.load(std::memory_order_relaxed);
+    stats.m_allocations = m_allocations.load(std::memory_order_relaxed);
+    stats.m_frees = m_frees.load(std::memory_order_relaxed);
+    for (int bucket = 0; bucket < LengthHistogram::kBuckets; ++bucket) {
+        stats.m_search_hops.m_counts[bucket] = m_search_hops[bucket].load(std::memory_order_relaxed);
+        stats.m_walk_lengths.m_counts[bucket] = m_walk_lengths[bucket].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+// Function zeroes the counters.
+inline void StatsCounters::reset()
+{
+    m_sorted_searches.store(0, std::memory_order_relaxed);
+    m_comparisons.store(0, std::memory_order_relaxed);
+    m_hops.store(0, std::memory_order_relaxed);
+    m_positional_walks.store(0, std::memory_order_relaxed);
+    m_walk_steps.store(0, std::memory_order_relaxed);
+    m_allocations.store(0, std::memory_order_relaxed);
+    m_frees.store(0, std::memory_order_relaxed);
+    for (int bucket = 0; bucket < LengthHistogram::kBuckets; ++bucket) {
+        m_search_hops[bucket].store(0, std::memory_order_relaxed);
+        m_walk_lengths[bucket].store(0, std::memory_order_relaxed);
+    }
+}
+
+#endif // LIST_STATS_IMPL_HPP_
@@ -1,28 +1,62 @@
 #ifndef NODE_HPP_
 #define NODE_HPP_
 
+#include <utility>
+
+template <typename T, typename Key = void>
+class Node;
+
+// Links of a node on one express lane above the sorted chain and above the insertion chain
+template <typename T, typename Key = void>
+struct Lane
+{
+    Node<T, Key>* m_greater;
+    Node<T, Key>* m_lesser;
+    Node<T, Key>* m_next;
+    Node<T, Key>* m_prev;
+    int m_span; // Number of insertion chain steps from this node to m_next
+};
+
+// Key a node is ordered by, cached when it is projected from the data
+template <typename T, typename Key>
+struct NodeKey
+{
+    Key m_key;
+};
+
+// Without a projection the data itself is the key, nothing is cached
 template <typename T>
-class Node
+struct NodeKey<T, void>
+{
+};
+
+// The key and the links come first, so the sorted search touches a small contiguous prefix of the node
+template <typename T, typename Key>
+class Node : public NodeKey<T, Key>
 {
 public:
     Node(); // Default constructor
     explicit Node(const T& data); // Constructor with parameter
+    template <typename... Args>
+    explicit Node(std::in_place_t, Args&&... args); // Constructs the data in place from the arguments
 
     
-    Node(const Node<T>& other); // Copy constructor
-    Node<T>& operator=(const Node<T>& other); // Copy assignment operator
+    Node(const Node<T, Key>& other); // Copy constructor
+    Node<T, Key>& operator=(const Node<T, Key>& other); // Copy assignment operator
 
-    Node(Node<T>&& other) noexcept; // Move constructor
-    Node<T>&& operator=(Node<T>&& other) noexcept; // Move assignment operator
+    Node(Node<T, Key>&& other) noexcept; // Move constructor
+    Node<T, Key>&& operator=(Node<T, Key>&& other) noexcept; // Move assignment operator
     
     ~Node() = default; // Destructor
 
 public:
+    Node<T, Key>* m_prev;
+    Node<T, Key>* m_next;
+    Node<T, Key>* m_greater;
+    Node<T, Key>* m_lesser;
+    Lane<T, Key>* m_lanes; // Express lanes, m_lanes[i] is level i + 1
+    int m_level; // Number of express lanes the node takes part in
     T m_data;
-    Node<T>* m_prev;
-    Node<T>* m_next;
-    Node<T>* m_greater;
-    Node<T>* m_lesser;
 };
 
 #include "node_impl_.hpp"
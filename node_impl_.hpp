@@ -3,41 +3,61 @@
 
 #include <utility>
 
-template <typename T>
-Node<T>::Node()
-    : m_data(0)
-    , m_prev(nullptr)
+template <typename T, typename Key>
+Node<T, Key>::Node()
+    : m_prev(nullptr)
     , m_next(nullptr)
     , m_greater(nullptr)
     , m_lesser(nullptr)
+    , m_lanes(nullptr)
+    , m_level(0)
+    , m_data(0)
 {
 }
 
-template <typename T>
-Node<T>::Node(const T& data)
-    : m_data(data)
-    , m_prev(nullptr)
+template <typename T, typename Key>
+Node<T, Key>::Node(const T& data)
+    : m_prev(nullptr)
     , m_next(nullptr)
     , m_greater(nullptr)
     , m_lesser(nullptr)
+    , m_lanes(nullptr)
+    , m_level(0)
+    , m_data(data)
 {
 }
 
+template <typename T, typename Key>
+template <typename... Args>
+Node<T, Key>::Node(std::in_place_t, Args&&... args)
+    : m_prev(nullptr)
+    , m_next(nullptr)
+    , m_greater(nullptr)
+    , m_lesser(nullptr)
+    , m_lanes(nullptr)
+    , m_level(0)
+    , m_data(std::forward<Args>(args)...)
+{
+}
 
-template <typename T>
-Node<T>::Node(const Node<T>& other)
-    : m_data(other.m_data)
+template <typename T, typename Key>
+Node<T, Key>::Node(const Node<T, Key>& other)
+    : NodeKey<T, Key>(other)
     , m_prev(nullptr)
     , m_next(nullptr)
     , m_greater(nullptr)
     , m_lesser(nullptr)
+    , m_lanes(nullptr)
+    , m_level(0)
+    , m_data(other.m_data)
 {
 }
 
-template <typename T>
-Node<T>& Node<T>::operator=(const Node<T>& other)
+template <typename T, typename Key>
+Node<T, Key>& Node<T, Key>::operator=(const Node<T, Key>& other)
 {
     if (this != &other) {
+        NodeKey<T, Key>::operator=(other);
         m_data = other.m_data;
         m_prev = nullptr;
         m_next = nullptr;
@@ -47,36 +67,46 @@ Node<T>& Node<T>::operator=(const Node<T>& other)
     return *this;
 }
 
-template <typename T>
-Node<T>::Node(Node<T>&& other) noexcept
-    : m_data(std::move(other.m_data))
+template <typename T, typename Key>
+Node<T, Key>::Node(Node<T, Key>&& other) noexcept
+    : NodeKey<T, Key>(std::move(other))
     , m_prev(other.m_prev)
     , m_next(other.m_next)
     , m_greater(other.m_greater)
     , m_lesser(other.m_lesser)
+    , m_lanes(other.m_lanes)
+    , m_level(other.m_level)
+    , m_data(std::move(other.m_data))
 {
     other.m_data = 0;
     other.m_next = nullptr;
     other.m_prev = nullptr;
     other.m_greater = nullptr;
     other.m_lesser = nullptr;
+    other.m_lanes = nullptr;
+    other.m_level = 0;
 }
 
-template <typename T>
-Node<T>&& Node<T>::operator=(Node<T>&& other) noexcept
+template <typename T, typename Key>
+Node<T, Key>&& Node<T, Key>::operator=(Node<T, Key>&& other) noexcept
 {
     if (this != &other) {
+        NodeKey<T, Key>::operator=(std::move(other));
         m_data = std::move(other.m_data);
         m_prev = other.m_prev;
         m_next = other.m_next;
         m_greater = other.m_greater;
         m_lesser = other.m_lesser;
+        m_lanes = other.m_lanes;
+        m_level = other.m_level;
 
         other.m_data = 0;
         other.m_next = nullptr;
         other.m_prev = nullptr;
         other.m_greater = nullptr;
         other.m_lesser = nullptr;
+        other.m_lanes = nullptr;
+        other.m_level = 0;
     }
     return *this;
 }
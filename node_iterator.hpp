@@ -0,0 +1,49 @@
+#ifndef NODE_ITERATOR_HPP_
+#define NODE_ITERATOR_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+// Bidirectional iterator walking a chain of nodes through the 'Forward' and 'Backward' links,
+// e.g. m_next/m_prev for the insertion order or m_greater/m_lesser for the sorted order.
+template <typename NodeT, typename Ref, NodeT* NodeT::*Forward, NodeT* NodeT::*Backward>
+class NodeIterator
+{
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = typename std::remove_const<typename std::remove_reference<Ref>::type>::type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = typename std::remove_reference<Ref>::type*;
+    using reference = Ref;
+
+    NodeIterator(); // Default constructor
+    NodeIterator(NodeT* node, NodeT* const* last); // Iterator at 'node', '*last' is where decrementing the end leads
+
+    template <typename OtherRef, typename = typename std::enable_if<std::is_convertible<OtherRef, Ref>::value>::type>
+    NodeIterator(const NodeIterator<NodeT, OtherRef, Forward, Backward>& other); // Mutable to constant conversion
+
+public:
+    reference operator*() const;
+    pointer operator->() const;
+
+    NodeIterator& operator++(); // Moves to the following node
+    NodeIterator operator++(int);
+    NodeIterator& operator--(); // Moves to the preceding node
+    NodeIterator operator--(int);
+
+    bool operator==(const NodeIterator& other) const;
+    bool operator!=(const NodeIterator& other) const;
+
+    // Getters
+    NodeT* get_node() const;
+    NodeT* const* get_last() const;
+
+private:
+    NodeT* m_node; // Current node, nullptr is the end
+    NodeT* const* m_last; // The list's pointer to the last node of the chain, read when the end is decremented
+};
+
+#include "node_iterator_impl_.hpp"
+
+#endif // NODE_ITERATOR_HPP_
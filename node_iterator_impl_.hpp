@@ -0,0 +1,104 @@
+#ifndef NODE_ITERATOR_IMPL_HPP_
+#define NODE_ITERATOR_IMPL_HPP_
+
+// Default constructor
+template <typename NodeT, typename Ref, NodeT* NodeT::*Forward, NodeT* NodeT::*Backward>
+NodeIterator<NodeT, Ref, Forward, Backward>::NodeIterator()
+    : m_node(nullptr)
+    , m_last(nullptr)
+{
+}
+
+// Constructor with the current node and the list's pointer to the last node of the chain
+template <typename NodeT, typename Ref, NodeT* NodeT::*Forward, NodeT* NodeT::*Backward>
+NodeIterator<NodeT, Ref, Forward, Backward>::NodeIterator(NodeT* node, NodeT* const* last)
+    : m_node(node)
+    , m_last(last)
+{
+}
+
+// Converting constructor from the mutable iterator
+template <typename NodeT, typename Ref, NodeT* NodeT::*Forward, NodeT* NodeT::*Backward>
+template <typename OtherRef, typename>
+NodeIterator<NodeT, Ref, Forward, Backward>::NodeIterator(const NodeIterator<NodeT, OtherRef, Forward, Backward>& other)
+    : m_node(other.get_node())
+    , m_last(other.get_last())
+{
+}
+
+// Return a reference to the data of the current node.
+template <typename NodeT, typename Ref, NodeT* NodeT::*Forward, NodeT* NodeT::*Backward>
+typename NodeIterator<NodeT, Ref, Forward, Backward>::reference NodeIterator<NodeT, Ref, Forward, Backward>::operator*() const
+{
+    return m_node->m_data;
+}
+
+// Return a pointer to the data of the current node.
+template <typename NodeT, typename Ref, NodeT* NodeT::*Forward, NodeT* NodeT::*Backward>
+typename NodeIterator<NodeT, Ref, Forward, Backward>::pointer NodeIterator<NodeT, Ref, Forward, Backward>::operator->() const
+{
+    return &m_node->m_data;
+}
+
+// Moves to the following node of the chain.
+template <typename NodeT, typename Ref, NodeT* NodeT::*Forward, NodeT* NodeT::*Backward>
+NodeIterator<NodeT, Ref, Forward, Backward>& NodeIterator<NodeT, Ref, Forward, Backward>::operator++()
+{
+    m_node = m_node->*Forward;
+    return *this;
+}
+
+template <typename NodeT, typename Ref, NodeT* NodeT::*Forward, NodeT* NodeT::*Backward>
+NodeIterator<NodeT, Ref, Forward, Backward> NodeIterator<NodeT, Ref, Forward, Backward>::operator++(int)
+{
+    NodeIterator tmp = *this;
+    ++*this;
+    return tmp;
+}
+
+// Moves to the preceding node of the chain. The end moves to the node that is last now, looked up in
+// the list, so an end iterator stays valid while the list changes.
+template <typename NodeT, typename Ref, NodeT* NodeT::*Forward, NodeT* NodeT::*Backward>
+NodeIterator<NodeT, Ref, Forward, Backward>& NodeIterator<NodeT, Ref, Forward, Backward>::operator--()
+{
+    m_node = m_node ? m_node->*Backward : *m_last;
+    return *this;
+}
+
+template <typename NodeT, typename Ref, NodeT* NodeT::*Forward, NodeT* NodeT::*Backward>
+NodeIterator<NodeT, Ref, Forward, Backward> NodeIterator<NodeT, Ref, Forward, Backward>::operator--(int)
+{
+    NodeIterator tmp = *this;
+    --*this;
+    return tmp;
+}
+
+// Checks that both iterators point to the same node
+template <typename NodeT, typename Ref, NodeT* NodeT::*Forward, NodeT* NodeT::*Backward>
+bool NodeIterator<NodeT, Ref, Forward, Backward>::operator==(const NodeIterator& other) const
+{
+    return m_node == other.m_node;
+}
+
+// Checks that the iterators point to different nodes
+template <typename NodeT, typename Ref, NodeT* NodeT::*Forward, NodeT* NodeT::*Backward>
+bool NodeIterator<NodeT, Ref, Forward, Backward>::operator!=(const NodeIterator& other) const
+{
+    return !(*this == other);
+}
+
+// Return the current node, nullptr for the end.
+template <typename NodeT, typename Ref, NodeT* NodeT::*Forward, NodeT* NodeT::*Backward>
+NodeT* NodeIterator<NodeT, Ref, Forward, Backward>::get_node() const
+{
+    return m_node;
+}
+
+// Return the list's pointer to the last node of the chain.
+template <typename NodeT, typename Ref, NodeT* NodeT::*Forward, NodeT* NodeT::*Backward>
+NodeT* const* NodeIterator<NodeT, Ref, Forward, Backward>::get_last() const
+{
+    return m_last;
+}
+
+#endif // NODE_ITERATOR_IMPL_HPP_
@@ -0,0 +1,32 @@
+#ifndef NODE_MAP_HPP_
+#define NODE_MAP_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Map from node (or element) addresses to values with a capacity fixed at construction.
+// Open addressing with linear probing over a single array, so filling it costs one allocation whatever the count.
+template <typename NodeT, typename Value>
+class NodeMap
+{
+public:
+    explicit NodeMap(int count); // Constructs a map able to hold 'count' nodes
+
+public:
+    void insert(const NodeT* node, const Value& value); // Adds a node that is not yet in the map
+    const Value& at(const NodeT* node) const; // Value of a node that is in the map
+
+private:
+    size_t slot_of(const NodeT* node) const; // First slot probed for a node
+
+private:
+    std::vector<std::pair<const NodeT*, Value>> m_slots; // A null node marks an empty slot
+    size_t m_mask; // Number of slots minus one, the number of slots is a power of two
+    int m_shift; // Bits dropped from the hash to get a slot index
+};
+
+#include "node_map_impl_.hpp"
+
+#endif // NODE_MAP_HPP_
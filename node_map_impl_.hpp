@@ -0,0 +1,54 @@
+#ifndef NODE_MAP_IMPL_HPP_
+#define NODE_MAP_IMPL_HPP_
+
+// Constructor, the slots are at least twice the count so probe sequences stay short.
+template <typename NodeT, typename Value>
+NodeMap<NodeT, Value>::NodeMap(int count)
+    : m_slots()
+    , m_mask(0)
+    , m_shift(64)
+{
+    size_t slots = 1;
+    while (slots < 2 * static_cast<size_t>(count > 0 ? count : 0)) {
+        slots *= 2;
+        --m_shift;
+    }
+    m_slots.assign(slots, std::pair<const NodeT*, Value>(nullptr, Value()));
+    m_mask = slots - 1;
+}
+
+// Function adds a node that is not yet in the map.
+template <typename NodeT, typename Value>
+void NodeMap<NodeT, Value>::insert(const NodeT* node, const Value& value)
+{
+    size_t slot = slot_of(node);
+    while (m_slots[slot].first) {
+        slot = (slot + 1) & m_mask;
+    }
+    m_slots[slot].first = node;
+    m_slots[slot].second = value;
+}
+
+// Function returns the value of a node that is in the map.
+template <typename NodeT, typename Value>
+const Value& NodeMap<NodeT, Value>::at(const NodeT* node) const
+{
+    size_t slot = slot_of(node);
+    while (m_slots[slot].first != node) {
+        slot = (slot + 1) & m_mask;
+    }
+    return m_slots[slot].second;
+}
+
+// Function hashes a node address by Fibonacci hashing, the top bits of the product pick the slot.
+template <typename NodeT, typename Value>
+size_t NodeMap<NodeT, Value>::slot_of(const NodeT* node) const
+{
+    if (m_shift == 64) {
+        return 0;
+    }
+    const uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(node)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(hash >> m_shift);
+}
+
+#endif // NODE_MAP_IMPL_HPP_
@@ -0,0 +1,66 @@
+#ifndef NODE_POOL_HPP_
+#define NODE_POOL_HPP_
+
+#include "node.hpp"
+#include <cstddef>
+
+// Slab allocator owning the nodes of one list and their express lanes.
+// Released nodes and lanes are recycled through free lists, all memory is returned at once by release().
+template <typename T, typename Key = void>
+class NodePool
+{
+public:
+    static constexpr int kMaxLevel = 16; // Highest express lane a node can take part in
+
+    NodePool(); // Default constructor
+
+    NodePool(const NodePool<T, Key>& other) = delete;
+    NodePool<T, Key>& operator=(const NodePool<T, Key>& other) = delete;
+
+    NodePool(NodePool<T, Key>&& other) noexcept; // Move constructor
+    NodePool<T, Key>& operator=(NodePool<T, Key>&& other) noexcept; // Move assignment operator
+
+    ~NodePool(); // Destructor
+
+public:
+    template <typename... Args>
+    Node<T, Key>* create(int level, Args&&... args); // Constructs a node with 'level' express lanes
+    void destroy(Node<T, Key>* elem); // Destroys a node and recycles its storage
+    void discard(Node<T, Key>* elem); // Destroys a node, its storage is reclaimed by release()
+
+    void release(); // Returns all slabs to the system
+    void adopt(NodePool<T, Key>& other); // Takes over all slabs of another pool
+    void swap(NodePool<T, Key>& other); // Swaps the contents
+
+private:
+    struct Slab
+    {
+        Slab* m_next;
+        size_t m_capacity;
+    };
+
+    struct FreeBlock
+    {
+        FreeBlock* m_next;
+    };
+
+    void* allocate(size_t bytes); // Carves storage from the current slab
+    void add_slab(size_t bytes); // Allocates a new slab big enough for 'bytes'
+    static constexpr size_t alignment(); // Alignment of the slabs and of every block carved from them
+    static size_t align_up(size_t value);
+
+private:
+    static constexpr size_t kMinSlabBytes = 4096;
+    static constexpr size_t kMaxSlabBytes = 1 << 20;
+
+    Slab* m_slabs; // Slabs in allocation order, newest first
+    char* m_cursor; // Next free byte in the newest slab
+    char* m_end; // End of the newest slab
+    size_t m_next_slab_bytes; // Size of the next slab, grows geometrically
+    FreeBlock* m_free_nodes; // Recycled node storage
+    FreeBlock* m_free_lanes[kMaxLevel]; // Recycled lane arrays, m_free_lanes[i] holds arrays of i + 1 lanes
+};
+
+#include "node_pool_impl_.hpp"
+
+#endif // NODE_POOL_HPP_
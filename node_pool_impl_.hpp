@@ -0,0 +1,233 @@
+#ifndef NODE_POOL_IMPL_HPP_
+#define NODE_POOL_IMPL_HPP_
+
+#include <new>
+#include <utility>
+
+// Default constructor
+template <typename T, typename Key>
+NodePool<T, Key>::NodePool()
+    : m_slabs(nullptr)
+    , m_cursor(nullptr)
+    , m_end(nullptr)
+    , m_next_slab_bytes(kMinSlabBytes)
+    , m_free_nodes(nullptr)
+    , m_free_lanes()
+{
+}
+
+// Move constructor
+template <typename T, typename Key>
+NodePool<T, Key>::NodePool(NodePool<T, Key>&& other) noexcept
+    : NodePool()
+{
+    swap(other);
+}
+
+// Move assignment operator
+template <typename T, typename Key>
+NodePool<T, Key>& NodePool<T, Key>::operator=(NodePool<T, Key>&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        swap(other);
+    }
+    return *this;
+}
+
+// Destructor
+template <typename T, typename Key>
+NodePool<T, Key>::~NodePool()
+{
+    release();
+}
+
+// Function constructs a node whose data is built in place from the given arguments, together with its express lanes.
+template <typename T, typename Key>
+template <typename... Args>
+Node<T, Key>* NodePool<T, Key>::create(int level, Args&&... args)
+{
+    // Reuse the storage of a released node if there is one
+    void* storage = m_free_nodes;
+    if (storage) {
+        m_free_nodes = m_free_nodes->m_next;
+    } else {
+        storage = allocate(sizeof(Node<T, Key>));
+    }
+
+    Node<T, Key>* new_node = nullptr;
+    try {
+        new_node = ::new (storage) Node<T, Key>(std::in_place, std::forward<Args>(args)...);
+    } catch (...) {
+        // Give the storage back if the value could not be constructed
+        FreeBlock* block = static_cast<FreeBlock*>(storage);
+        block->m_next = m_free_nodes;
+        m_free_nodes = block;
+        throw;
+    }
+
+    // Attach the express lanes, reusing a released array of the same level if possible
+    if (level > 0) {
+        void* lanes = m_free_lanes[level - 1];
+        if (lanes) {
+            m_free_lanes[level - 1] = m_free_lanes[level - 1]->m_next;
+        } else {
+            lanes = allocate(sizeof(Lane<T, Key>) * level);
+        }
+        new_node->m_lanes = static_cast<Lane<T, Key>*>(lanes);
+        for (int i = 0; i < level; ++i) {
+            ::new (&new_node->m_lanes[i]) Lane<T, Key>();
+        }
+    }
+    new_node->m_level = level;
+    return new_node;
+}
+
+// Function destroys a node and puts its storage and its lanes on the free lists.
+template <typename T, typename Key>
+void NodePool<T, Key>::destroy(Node<T, Key>* elem)
+{
+    if (elem->m_level > 0) {
+        FreeBlock* lanes = reinterpret_cast<FreeBlock*>(elem->m_lanes);
+        lanes->m_next = m_free_lanes[elem->m_level - 1];
+        m_free_lanes[elem->m_level - 1] = lanes;
+    }
+
+    elem->~Node<T, Key>();
+
+    FreeBlock* block = reinterpret_cast<FreeBlock*>(elem);
+    block->m_next = m_free_nodes;
+    m_free_nodes = block;
+}
+
+// Function destroys a node without recycling its storage, it is reclaimed by the next release().
+template <typename T, typename Key>
+void NodePool<T, Key>::discard(Node<T, Key>* elem)
+{
+    elem->~Node<T, Key>();
+}
+
+// Function returns all slabs to the system. Nodes still living in the pool must have been destroyed or discarded.
+template <typename T, typename Key>
+void NodePool<T, Key>::release()
+{
+    while (m_slabs) {
+        Slab* tmp = m_slabs;
+        m_slabs = m_slabs->m_next;
+        ::operator delete(tmp, std::align_val_t(alignment()));
+    }
+
+    m_cursor = nullptr;
+    m_end = nullptr;
+    m_next_slab_bytes = kMinSlabBytes;
+    m_free_nodes = nullptr;
+    for (int i = 0; i < kMaxLevel; ++i) {
+        m_free_lanes[i] = nullptr;
+    }
+}
+
+// Function takes over all slabs of another pool, so nodes moved between lists stay owned.
+template <typename T, typename Key>
+void NodePool<T, Key>::adopt(NodePool<T, Key>& other)
+{
+    if (this == &other || !other.m_slabs) {
+        return;
+    }
+
+    // Append the slabs of 'other' behind our own, our newest slab stays the one we carve from
+    if (m_slabs) {
+        Slab* last = m_slabs;
+        while (last->m_next) {
+            last = last->m_next;
+        }
+        last->m_next = other.m_slabs;
+    } else {
+        m_slabs = other.m_slabs;
+        m_cursor = other.m_cursor;
+        m_end = other.m_end;
+        m_next_slab_bytes = other.m_next_slab_bytes;
+    }
+
+    // Keep the recycled storage of 'other' available
+    while (other.m_free_nodes) {
+        FreeBlock* block = other.m_free_nodes;
+        other.m_free_nodes = block->m_next;
+        block->m_next = m_free_nodes;
+        m_free_nodes = block;
+    }
+    for (int i = 0; i < kMaxLevel; ++i) {
+        while (other.m_free_lanes[i]) {
+            FreeBlock* block = other.m_free_lanes[i];
+            other.m_free_lanes[i] = block->m_next;
+            block->m_next = m_free_lanes[i];
+            m_free_lanes[i] = block;
+        }
+    }
+
+    other.m_slabs = nullptr;
+    other.release();
+}
+
+// Swaps the contents.
+template <typename T, typename Key>
+void NodePool<T, Key>::swap(NodePool<T, Key>& other)
+{
+    std::swap(m_slabs, other.m_slabs);
+    std::swap(m_cursor, other.m_cursor);
+    std::swap(m_end, other.m_end);
+    std::swap(m_next_slab_bytes, other.m_next_slab_bytes);
+    std::swap(m_free_nodes, other.m_free_nodes);
+    std::swap(m_free_lanes, other.m_free_lanes);
+}
+
+// Function carves 'bytes' of storage from the newest slab, allocating a new one when it is full.
+template <typename T, typename Key>
+void* NodePool<T, Key>::allocate(size_t bytes)
+{
+    bytes = align_up(bytes);
+    if (static_cast<size_t>(m_end - m_cursor) < bytes) {
+        add_slab(bytes);
+    }
+
+    void* storage = m_cursor;
+    m_cursor += bytes;
+    return storage;
+}
+
+// Function allocates a new slab, each slab doubles the size of the previous one up to kMaxSlabBytes.
+template <typename T, typename Key>
+void NodePool<T, Key>::add_slab(size_t bytes)
+{
+    const size_t header = align_up(sizeof(Slab));
+    size_t capacity = m_next_slab_bytes;
+    while (capacity < header + bytes) {
+        capacity *= 2;
+    }
+    if (m_next_slab_bytes < kMaxSlabBytes) {
+        m_next_slab_bytes *= 2;
+    }
+
+    Slab* slab = static_cast<Slab*>(::operator new(capacity, std::align_val_t(alignment())));
+    slab->m_next = m_slabs;
+    slab->m_capacity = capacity;
+    m_slabs = slab;
+
+    m_cursor = reinterpret_cast<char*>(slab) + header;
+    m_end = reinterpret_cast<char*>(slab) + capacity;
+}
+
+// Function returns the alignment of every block, slabs are allocated with it so over-aligned elements are supported.
+template <typename T, typename Key>
+constexpr size_t NodePool<T, Key>::alignment()
+{
+    return alignof(Node<T, Key>) > alignof(FreeBlock) ? alignof(Node<T, Key>) : alignof(FreeBlock);
+}
+
+// Function rounds a size up so that every block keeps the alignment of a node.
+template <typename T, typename Key>
+size_t NodePool<T, Key>::align_up(size_t value)
+{
+    return (value + alignment() - 1) / alignment() * alignment();
+}
+
+#endif // NODE_POOL_IMPL_HPP_
@@ -0,0 +1,16 @@
+#ifndef PROJECTION_HPP_
+#define PROJECTION_HPP_
+
+#include <utility>
+
+// Default projection, orders the elements by their own value
+struct IdentityProjection
+{
+    template <typename U>
+    constexpr U&& operator()(U&& value) const noexcept
+    {
+        return std::forward<U>(value);
+    }
+};
+
+#endif // PROJECTION_HPP_
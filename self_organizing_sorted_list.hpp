@@ -1,23 +1,78 @@
 #ifndef SELF_ORGANIZING_SORTED_LIST_HPP_
 #define SELF_ORGANIZING_SORTED_LIST_HPP_
 
+#include "list_stats.hpp"
 #include "node.hpp"
+#include "node_iterator.hpp"
+#include "node_map.hpp"
+#include "node_pool.hpp"
+#include "projection.hpp"
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
+#include <istream>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
-template <typename T>
+// Default parser of ingest(), reads one value with operator>>
+struct ExtractionParser
+{
+    template <typename U>
+    bool operator()(std::istream& in, U& value) const
+    {
+        return static_cast<bool>(in >> value);
+    }
+};
+
+/* Compare orders the keys (operator< by default) and Projection maps an element to the key it is
+   ordered by (the element itself by default). A projected key is cached inside every node, so the
+   sorted search only touches the keys and the links.
+   With UniqueKeys the list behaves as a set: an element whose key is already present is rejected. */
+template <typename T, typename Compare = std::less<>, typename Projection = IdentityProjection, bool UniqueKeys = false>
 class SelfOrganizingSortedList
 {
+public:
+    using value_type = T;
+    using key_type = typename std::decay<decltype(std::declval<const Projection&>()(std::declval<const T&>()))>::type;
+    using key_compare = Compare;
+    using projection_type = Projection;
+    static constexpr bool unique_keys = UniqueKeys;
+
+    // Node types, a key is cached only when it differs from the element
+    using cached_key_type = typename std::conditional<std::is_same<Projection, IdentityProjection>::value, void, key_type>::type;
+    using node_type = Node<T, cached_key_type>;
+    using lane_type = Lane<T, cached_key_type>;
+    using pool_type = NodePool<T, cached_key_type>;
+
+    // Insertion order iterators, read-only since changing a value would break the order
+    using const_iterator = NodeIterator<node_type, const T&, &node_type::m_next, &node_type::m_prev>;
+    using iterator = const_iterator;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using reverse_iterator = const_reverse_iterator;
+
+    // Sorted order iterators
+    using sorted_iterator = NodeIterator<node_type, const T&, &node_type::m_greater, &node_type::m_lesser>;
+    using reverse_sorted_iterator = std::reverse_iterator<sorted_iterator>;
+
 public:
     SelfOrganizingSortedList(); // Default constructor
+    explicit SelfOrganizingSortedList(const Compare& compare, const Projection& projection = Projection()); // Constructor with an ordering
     
-    SelfOrganizingSortedList(const SelfOrganizingSortedList<T>& other); // Copy constructor
-    SelfOrganizingSortedList<T>& operator=(const SelfOrganizingSortedList<T>& other); // Copy assignment operator
+    SelfOrganizingSortedList(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& other); // Copy constructor
+    SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& operator=(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& other); // Copy assignment operator
     
-    SelfOrganizingSortedList(SelfOrganizingSortedList<T>&& other); // Move constructor
-    SelfOrganizingSortedList<T>& operator=(SelfOrganizingSortedList<T>&& other); // Move assignment operator
+    SelfOrganizingSortedList(SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>&& other); // Move constructor
+    SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& operator=(SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>&& other); // Move assignment operator
 
     SelfOrganizingSortedList(std::initializer_list<T> init_list); // Constructor with initializer list
+
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    SelfOrganizingSortedList(InputIt first, InputIt last); // Constructor with a range of values
+    template <typename ForwardIt, typename = typename std::iterator_traits<ForwardIt>::iterator_category>
+    SelfOrganizingSortedList(ForwardIt first, ForwardIt last, int threads); // Same, loading the range on several threads
     
     ~SelfOrganizingSortedList();  // Destructor
 
@@ -25,14 +80,33 @@ public:
     // Member functions
     void assign(const T& value, size_t count); // Assigns values to the container
     void assign(std::initializer_list<T> init_list);
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    void assign(InputIt first, InputIt last);
+    template <typename ForwardIt, typename = typename std::iterator_traits<ForwardIt>::iterator_category>
+    void assign(ForwardIt first, ForwardIt last, int threads); // Same, allocating, sorting and linking on several threads
 
     // Modifiers
-    void push_back(const T& value); // Adds an element to the end
-    void push_front(const T& value); // Inserts an element to the beginning
+    bool push_back(const T& value); // Adds an element to the end, returns whether it was added
+    bool push_back(T&& value);
+    bool push_front(const T& value); // Inserts an element to the beginning, returns whether it was added
+    bool push_front(T&& value);
 
-    void insert(const T& value, const int pos); // Inserts elements
-    void insert(T&& value, const int pos);
+    template <typename... Args>
+    const T& emplace_back(Args&&... args); // Constructs an element in place at the end
+    template <typename... Args>
+    iterator emplace(const int pos, Args&&... args); // Constructs an element in place at a position
+    template <typename... Args>
+    sorted_iterator emplace_sorted(Args&&... args); // Constructs an element in place at the end, returns its sorted position
+
+    bool insert(const T& value, const int pos); // Inserts elements, returns whether it was added
+    bool insert(T&& value, const int pos);
     void insert(const T& value, const int pos, const int count); // Adds elements by the given amount
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    int push_back_batch(InputIt first, InputIt last); // Adds a range to the end with one sorted merge, returns how many were added
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    int insert_batch(const int pos, InputIt first, InputIt last); // Inserts a range at a position with one sorted merge
+    template <typename Parser = ExtractionParser>
+    int ingest(std::istream& in, Parser parser = Parser(), int chunk_size = kIngestChunkSize); // Appends values parsed from a stream chunk by chunk
 
     void erase(int pos); // Erases elements
     void erase(int pos, int count);
@@ -44,22 +118,55 @@ public:
 
     void resize(size_t count); // Changes the number of elements stored
     void emplace_front(size_t count); // Changes the number of elements stored
-    void swap(SelfOrganizingSortedList<T>& other); // Swaps the contents
+    void swap(SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& other); // Swaps the contents
 
     // Operations
     void remove(const T& val); // Removes elements satisfying specific criteria
-    void remove_if(std::function<bool(const T&)> condition); 
-    void splice(int pos, const SelfOrganizingSortedList<T>& other); // Moves elements from another list
+    bool remove_one(const key_type& key); // Removes the first element with an equivalent key in sorted order
+    T extract(const key_type& key); // Removes the first element with an equivalent key and returns it
+    template <typename Predicate>
+    void remove_if(Predicate&& condition); // Removes the elements for which condition returns true
+    template <typename Predicate>
+    void remove_if(Predicate&& condition, int threads); // Same, evaluating condition on several threads
+    void splice(int pos, const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& other); // Moves elements from another list
     void reverse(); // Reverses the order of the elements
     void unique(); // Removes duplicate elements
     void sort(); // Sorts the elements
-    void merge(SelfOrganizingSortedList<T>& other); // merges two lists
+    void merge(SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& other); // merges two lists
+
+    // Lookup
+    bool contains(const key_type& key) const; // Checks whether an element with an equivalent key exists
+    sorted_iterator find(const key_type& key) const; // Finds the first element with an equivalent key in sorted order
+    int count(const key_type& key) const; // Returns the number of elements with an equivalent key
+    sorted_iterator lower_bound(const key_type& key) const; // First element whose key is not less than key
+    sorted_iterator upper_bound(const key_type& key) const; // First element whose key is greater than key
+    std::pair<sorted_iterator, sorted_iterator> equal_range(const key_type& key) const; // Range of equivalent elements
+
+    // Key ranges [lo, hi)
+    template <typename Function>
+    void for_each_in_range(const key_type& lo, const key_type& hi, Function fn) const; // Calls fn on every element in ascending order
+    int count_range(const key_type& lo, const key_type& hi) const; // Returns the number of elements in the range
+    int erase_range(const key_type& lo, const key_type& hi); // Removes the elements in the range, returns how many
 
     // Element access
-    T& front(); // Access the first element
-    const T& front() const;
-    T& back(); // Access the last element
-    const T& back() const;
+    const T& front() const; // Access the first element
+    const T& back() const; // Access the last element
+    const T& at(int pos) const; // Access an element by position, with bounds checking
+    const T& operator[](int pos) const; // Access an element by position
+
+    // Iterators
+    const_iterator begin() const; // Insertion order
+    const_iterator cbegin() const;
+    const_iterator end() const;
+    const_iterator cend() const;
+    const_reverse_iterator rbegin() const; // Reverse insertion order
+    const_reverse_iterator crbegin() const;
+    const_reverse_iterator rend() const;
+    const_reverse_iterator crend() const;
+    sorted_iterator sorted_begin() const; // Ascending order
+    sorted_iterator sorted_end() const;
+    reverse_sorted_iterator sorted_rbegin() const; // Descending order
+    reverse_sorted_iterator sorted_rend() const;
 
     // Capacity
     bool empty() const; // Checks whether the container is empty
@@ -72,40 +179,138 @@ public:
     void print_desc();
 
     // getters prt
-    Node<T>* get_head() const;
+    node_type* get_head() const;
+
+#ifdef SOSL_ENABLE_STATS
+    // Statistics, only with SOSL_ENABLE_STATS
+    ListStats stats() const; // Counters of the work done since construction or reset_stats()
+    void reset_stats(); // Zeroes the counters
+#endif
     
 private:
-    void put_in_sorted_order(Node<T>* elem); // Function to insert a node into sorted order in the list
-    void remove_sorted_node(Node<T>* elem); // Function to remove a node from sorted order in the list
-    void advance_node(Node<T>* elem); 
+    // Snapshots (see snapshot.hpp) link a loaded file straight into both orders
+    template <typename U, typename C, typename P, bool K>
+    friend void load_snapshot(SelfOrganizingSortedList<U, C, P, K>& list, const std::string& path);
+
+    // Arithmetic keys are passed by value and compared directly under the default ordering
+    using key_arg = typename std::conditional<std::is_arithmetic<key_type>::value, key_type, const key_type&>::type;
+    static constexpr bool kDirectCompare = std::is_arithmetic<key_type>::value
+        && (std::is_same<Compare, std::less<>>::value || std::is_same<Compare, std::less<key_type>>::value);
+
+    // Keys
+    const key_type& key_of(const node_type* elem) const; // Key a node is ordered by
+    void cache_key(node_type* elem); // Stores the projected key of a new node
+    bool key_less(key_arg lhs, key_arg rhs) const; // Checks whether lhs is ordered before rhs
+    bool key_equal(key_arg lhs, key_arg rhs) const; // Checks whether the keys are equivalent
+    bool search_less(key_arg lhs, key_arg rhs, SearchCost& cost) const; // key_less, counted as a comparison of a sorted search
+
+    node_type* put_in_sorted_order(node_type* elem); // Function to insert a node into sorted order in the list, returns the node holding its key
+    void remove_sorted_node(node_type* elem); // Function to remove a node from sorted order in the list
+    void advance_node(node_type* elem); 
+
+    // Express lanes
+    template <typename... Args>
+    node_type* create_node(Args&&... args); // Allocates a node and its express lanes
+    template <typename... Args>
+    std::pair<node_type*, bool> emplace_node(node_type* prev, Args&&... args); // Creates a node and links it into both orders
+    void destroy_node(node_type* elem); // Releases a node and its express lanes
+    void erase_node(node_type* elem); // Unlinks a node from both orders and releases it
+    template <typename InputIt>
+    int emplace_batch(node_type* prev, InputIt first, InputIt last); // Links a range after prev, merging it into the sorted chain
+    void merge_batch(std::vector<node_type*>& batch); // Merges unlinked nodes into the sorted chain in one sweep
+    template <typename Function>
+    void remove_nodes_if(Function is_victim); // Unlinks the accepted nodes in one pass and releases them
+    int random_level(); // Draws the number of express lanes for a new node
+    static int draw_level(unsigned int& seed); // Draws a level from a generator state
+    node_type* find_sorted_predecessor(key_arg key, SearchCost& cost) const; // Last node in sorted order whose key is less than key
+    node_type* locate_sorted_predecessor(key_arg key, SearchCost& cost) const; // Same, trying both ends and the finger first
+    node_type* find_sorted_last_not_greater(key_arg key, SearchCost& cost) const; // Last node in sorted order whose key is not greater than key
+    node_type*& greater_link(node_type* elem, int level); // 'greater' link at level, nullptr elem is the list head
+    node_type* greater_link(node_type* elem, int level) const;
+    node_type*& lesser_link(node_type* elem, int level); // 'lesser' link at level, nullptr elem is the list head
+    node_type* lesser_link(node_type* elem, int level) const;
+    void reset_lanes(); // Forgets all express lanes of the list
+    void link_sorted_order(const std::vector<node_type*>& nodes); // Rebuilds the sorted chain and lanes from nodes in sorted order
+    void link_sorted_order(const std::vector<node_type*>& nodes, int threads); // Same, linking segments on several threads
+    void link_sorted_lanes(); // Rebuilds the sorted lanes from the sorted chain
+    void copy_from(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& other); // Clones both orders of another list into an empty one
+    void assign_orders(const T* values, const uint32_t* order, int count); // Replaces the contents with values in insertion order and their checked sorted order
+
+    // Positional express lanes
+    node_type*& next_link(node_type* elem, int level); // 'next' link at level, nullptr elem is the list head
+    node_type* next_link(node_type* elem, int level) const;
+    node_type*& prev_link(node_type* elem, int level); // 'prev' link at level, nullptr elem is the list head
+    int& span_link(node_type* elem, int level); // Steps covered by the 'next' link at level
+    int span_link(node_type* elem, int level) const;
+    node_type* node_at(int pos) const; // Node at a position in O(log n)
+    void link_after(node_type* prev, node_type* elem); // Links a node into the insertion order after prev
+    void unlink(node_type* elem); // Unlinks a node from the insertion order
+    void link_insertion_order(); // Rebuilds the positional lanes from the insertion chain
+    void link_insertion_order(const std::vector<node_type*>& nodes, int threads); // Links the insertion chain and its lanes from nodes in order
+
+    // Parallel building blocks
+    template <typename Function>
+    static void run_chunks(int chunks, Function task); // Runs task(chunk) for every chunk on its own thread, rethrows the first failure
+    template <typename Less>
+    static void parallel_sort(std::vector<int>& order, Less less, int threads); // Stable sort of sorted runs merged pairwise
+    void append_insertion_order(SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& other); // Appends the insertion chain of another list
 
 private:
-    Node<T>* m_head;
-    Node<T>* m_tail;
-    Node<T>* m_asc_head;
-    Node<T>* m_desc_head;
+    static constexpr int kMaxLevel = pool_type::kMaxLevel; // Supports about 4^16 elements with p = 1/4
+    static constexpr int kFingerSteps = 8; // Sorted chain steps tried around the finger before searching
+    static constexpr int kMinParallelChunk = 4096; // Fewest elements worth a thread of their own
+    static constexpr int kIngestChunkSize = 65536; // Values parsed ahead by ingest()
+
+    // First and last node of a segment on every express level, with their positions in the segment's order
+    struct SegmentEnds
+    {
+        node_type* m_first[kMaxLevel + 1];
+        node_type* m_last[kMaxLevel + 1];
+        int m_first_pos[kMaxLevel + 1];
+        int m_last_pos[kMaxLevel + 1];
+        int m_level; // Highest level of a node in the segment
+    };
+
+    node_type* m_head;
+    node_type* m_tail;
+    node_type* m_asc_head;
+    node_type* m_desc_head;
     int m_size;
+    lane_type m_lane_heads[kMaxLevel]; // First (m_greater) and last (m_lesser) node of every express lane
+    int m_level; // Highest express lane in use
+    unsigned int m_seed; // State of the level generator
+    node_type* m_finger; // Last inserted node, where the next sorted search starts
+    pool_type m_pool; // Storage of the nodes and their express lanes
+    Compare m_compare; // Orders the keys
+    Projection m_projection; // Maps an element to its key
+#ifdef SOSL_ENABLE_STATS
+    mutable StatsCounters m_stats; // Updated by const lookups too, from any thread
+#endif
 };
 
+// Sorted list that keeps a single element per key
+template <typename T, typename Compare = std::less<>, typename Projection = IdentityProjection>
+using SelfOrganizingSortedSet = SelfOrganizingSortedList<T, Compare, Projection, true>;
+
 // Non-member functions
 // Lexicographically compares the values in the list
-template <typename T>
-bool operator==(const SelfOrganizingSortedList<T>& lhs, const SelfOrganizingSortedList<T>& rhs);
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool operator==(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& lhs, const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& rhs);
 
-template <typename T>
-bool operator!=(const SelfOrganizingSortedList<T>& lhs, const SelfOrganizingSortedList<T>& rhs);
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool operator!=(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& lhs, const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& rhs);
 
-template <typename T>
-bool operator<(const SelfOrganizingSortedList<T>& lhs, const SelfOrganizingSortedList<T>& rhs);
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool operator<(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& lhs, const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& rhs);
 
-template <typename T>
-bool operator<=(const SelfOrganizingSortedList<T>& lhs, const SelfOrganizingSortedList<T>& rhs);
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool operator<=(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& lhs, const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& rhs);
 
-template <typename T>
-bool operator>(const SelfOrganizingSortedList<T>& lhs, const SelfOrganizingSortedList<T>& rhs);
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool operator>(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& lhs, const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& rhs);
 
-template <typename T>
-bool operator>=(const SelfOrganizingSortedList<T>& lhs, const SelfOrganizingSortedList<T>& rhs);
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool operator>=(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& lhs, const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& rhs);
 
 #include "self_organizing_sorted_list_impl_.hpp"
 
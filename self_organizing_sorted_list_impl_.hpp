@@ -1,71 +1,165 @@
 #ifndef SELF_ORGANIZING_SORTED_LIST_IMPL_
 #define SELF_ORGANIZING_SORTED_LIST_IMPL_
 
+#include <algorithm>
+#include <exception>
+#include <future>
 #include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
 #include <utility>
 
 // Default constructor
-template <typename T>
-SelfOrganizingSortedList<T>::SelfOrganizingSortedList()
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::SelfOrganizingSortedList()
+    : SelfOrganizingSortedList(Compare(), Projection())
+{
+}
+
+// Constructor with a comparator and a projection
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::SelfOrganizingSortedList(const Compare& compare, const Projection& projection)
     : m_head(nullptr)
     , m_tail(nullptr)
     , m_asc_head(nullptr)
     , m_desc_head(nullptr)
     , m_size(0)
+    , m_lane_heads()
+    , m_level(0)
+    , m_seed(0x9E3779B9u)
+    , m_finger(nullptr)
+    , m_pool()
+    , m_compare(compare)
+    , m_projection(projection)
 {
 }
 
 // Copy constructor
-template <typename T>
-SelfOrganizingSortedList<T>::SelfOrganizingSortedList(const SelfOrganizingSortedList<T>& other)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::SelfOrganizingSortedList(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& other)
     : m_head(nullptr)
     , m_tail(nullptr)
     , m_asc_head(nullptr)
     , m_desc_head(nullptr)
     , m_size(0)
+    , m_lane_heads()
+    , m_level(0)
+    , m_seed(0x9E3779B9u)
+    , m_finger(nullptr)
+    , m_pool()
+    , m_compare(other.m_compare)
+    , m_projection(other.m_projection)
 {
-    Node<T>* cur = other.m_head;
-    while (cur) {
-        push_back(cur->m_data);
-        cur = cur->m_next;
-    }
+    copy_from(other);
 }
 
 // Copy assignment operator
-template <typename T>
-SelfOrganizingSortedList<T>& SelfOrganizingSortedList<T>::operator=(const SelfOrganizingSortedList<T>& other)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::operator=(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& other)
 {
     if (this != &other) {
         clear();
+        m_compare = other.m_compare;
+        m_projection = other.m_projection;
+        copy_from(other);
+    }
+    return *this;
+}
 
-        Node<T>* cur = other.m_head;
-        while (cur) {
-            push_back(cur->m_data);
-            cur = cur->m_next;
+// Function clones the nodes of another list, preserving both its insertion and its sorted order in linear time.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::copy_from(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& other)
+{
+    // Remember which clone belongs to which node of 'other'
+    NodeMap<node_type, node_type*> clones(other.m_size);
+
+    try {
+        // Clone the nodes in insertion order
+        for (const node_type* cur = other.m_head; cur; cur = cur->m_next) {
+            node_type* new_node = create_node(cur->m_data);
+            link_after(m_tail, new_node);
+            ++m_size;
+            clones.insert(cur, new_node);
         }
+    } catch (...) {
+        clear();
+        throw;
     }
-    return *this;
+
+    // The sorted order of 'other' is already valid, take it over without comparing
+    std::vector<node_type*> nodes;
+    nodes.reserve(m_size);
+    for (const node_type* cur = other.m_asc_head; cur; cur = cur->m_greater) {
+        nodes.push_back(clones.at(cur));
+    }
+    link_sorted_order(nodes);
+}
+
+/* Function replaces the contents with values given in insertion order and, as insertion indices, their sorted
+   order. One node is created per value and both chains are linked straight from the orders, so no key is
+   compared. The caller has checked that order names every value exactly once. */
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::assign_orders(const T* values, const uint32_t* order, int count)
+{
+    // Start with a fresh list
+    clear();
+
+    std::vector<node_type*> nodes;
+    nodes.reserve(count);
+    try {
+        for (int pos = 0; pos < count; ++pos) {
+            nodes.push_back(create_node(values[pos]));
+        }
+    } catch (...) {
+        for (node_type* elem : nodes) {
+            destroy_node(elem);
+        }
+        throw;
+    }
+
+    std::vector<node_type*> sorted(count);
+    for (int rank = 0; rank < count; ++rank) {
+        sorted[rank] = nodes[order[rank]];
+    }
+
+    link_insertion_order(nodes, 1);
+    link_sorted_order(sorted);
+    m_size = count;
 }
 
 // Move constructor
-template <typename T>
-SelfOrganizingSortedList<T>::SelfOrganizingSortedList(SelfOrganizingSortedList<T>&& other)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::SelfOrganizingSortedList(SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>&& other)
     : m_head(other.m_head)
     , m_tail(other.m_tail)
     , m_asc_head(other.m_asc_head)
     , m_desc_head(other.m_desc_head)
     , m_size(other.m_size)
+    , m_lane_heads()
+    , m_level(other.m_level)
+    , m_seed(other.m_seed)
+    , m_finger(other.m_finger)
+    , m_pool(std::move(other.m_pool))
+    , m_compare(other.m_compare)
+    , m_projection(other.m_projection)
 {
+    for (int i = 0; i < m_level; ++i) {
+        m_lane_heads[i] = other.m_lane_heads[i];
+    }
+
     other.m_head = nullptr;
     other.m_tail = nullptr;
     other.m_asc_head = nullptr;
     other.m_desc_head = nullptr;
     other.m_size = 0;
+    other.reset_lanes();
+    SOSL_STATS(m_stats.transfer_allocations(other.m_stats, static_cast<uint64_t>(m_size));)
 }
 
 // Move assignment operator
-template <typename T>
-SelfOrganizingSortedList<T>& SelfOrganizingSortedList<T>::operator=(SelfOrganizingSortedList<T>&& other)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::operator=(SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>&& other)
 {
     if (this != &other) {
         clear();
@@ -75,136 +169,389 @@ SelfOrganizingSortedList<T>& SelfOrganizingSortedList<T>::operator=(SelfOrganizi
         m_asc_head = other.m_asc_head;
         m_desc_head = other.m_desc_head;
         m_size = other.m_size;
+        m_level = other.m_level;
+        for (int i = 0; i < m_level; ++i) {
+            m_lane_heads[i] = other.m_lane_heads[i];
+        }
+        m_finger = other.m_finger;
+        m_pool.swap(other.m_pool);
+        m_compare = other.m_compare;
+        m_projection = other.m_projection;
+        SOSL_STATS(m_stats.transfer_allocations(other.m_stats, static_cast<uint64_t>(m_size));)
         
         other.m_head = nullptr;
         other.m_tail = nullptr;
         other.m_asc_head = nullptr;
         other.m_desc_head = nullptr;
         other.m_size = 0;
+        other.reset_lanes();
     }   
     return *this;
 }
 
 // Constructor with initializer list
-template <typename T>
-SelfOrganizingSortedList<T>::SelfOrganizingSortedList(std::initializer_list<T> init_list)
-    : m_head(nullptr)
-    , m_tail(nullptr)
-    , m_asc_head(nullptr)
-    , m_desc_head(nullptr)
-    , m_size(0)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::SelfOrganizingSortedList(std::initializer_list<T> init_list)
+    : SelfOrganizingSortedList(init_list.begin(), init_list.end())
 {
-    for (const T& elem : init_list) {
-        push_back(elem);
-    }
+}
+
+// Constructor with a range of values
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename InputIt, typename>
+SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::SelfOrganizingSortedList(InputIt first, InputIt last)
+    : SelfOrganizingSortedList()
+{
+    assign(first, last);
+}
+
+// Constructor with a range of values, allocated, sorted and linked on several threads
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename ForwardIt, typename>
+SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::SelfOrganizingSortedList(ForwardIt first, ForwardIt last, int threads)
+    : SelfOrganizingSortedList()
+{
+    assign(first, last, threads);
 }
 
 // Destructor
-template <typename T>
-SelfOrganizingSortedList<T>::~SelfOrganizingSortedList()
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::~SelfOrganizingSortedList()
 {
     clear();
 }
 
 // Removes all nodes from the list
-template <typename T>
-void SelfOrganizingSortedList<T>::clear()
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::clear()
 {
-    // Start by clearing the list while m_head is not nullptr
-    while (m_head) {
-        Node<T>* tmp = m_head;
-        m_head = m_head->m_next;
-        delete tmp;
+    // Destroy the values that need it, trivially destructible ones are simply dropped with the slabs
+    if (!std::is_trivially_destructible<T>::value) {
+        while (m_head) {
+            node_type* tmp = m_head;
+            m_head = m_head->m_next;
+            m_pool.discard(tmp);
+        }
     }
 
+    // Return all node storage at once
+    SOSL_STATS(m_stats.record_frees(static_cast<uint64_t>(m_size));)
+    m_pool.release();
+
     // After the loop, the list is empty, so set all relevant pointers to nullptr
     m_head = nullptr;
     m_tail = nullptr;
     m_asc_head = nullptr;
     m_desc_head = nullptr;
     m_size = 0;
+    reset_lanes();
 }
 
-// Adds a new node with the given value to the end of the list
-template <typename T>
-void SelfOrganizingSortedList<T>::push_back(const T& value)
+// Adds a new node with the given value to the end of the list, returns whether it was added
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::push_back(const T& value)
 {
-    // Create a new node containing the given 'value'
-    Node<T>* new_node = new Node<T>(value);
+    return emplace_node(m_tail, value).second;
+}
 
-    // Check if the list is empty
-    if (!m_head) {
-        // If it's empty, set both head and tail to the new node
-        m_head = new_node;
-        m_tail = new_node;
-    } else {
-        // If the list is not empty, connect the new node to the end of the list
-        new_node->m_prev = m_tail;
-        m_tail->m_next = new_node;
-        m_tail = new_node;
-    }
-    put_in_sorted_order(new_node);
-    ++m_size;
+// Adds a new node to the end of the list, moving the given value into it
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::push_back(T&& value)
+{
+    return emplace_node(m_tail, std::move(value)).second;
 }
 
 // Adds a new node with the given value to the front of a list. 
-template <typename T>
-void SelfOrganizingSortedList<T>::push_front(const T& value)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::push_front(const T& value)
 {
-    // Create a new node containing the given 'value'
-    Node<T>* new_node = new Node<T>(value);
+    return emplace_node(nullptr, value).second;
+}
 
-    // Check if the list is empty
-    if (!m_head) {
-        // If it's empty, set both head and tail to the new node
-        m_head = new_node;
-        m_tail = new_node;
-    } else {
-        // If the list is not empty, insert the new node at the front
-        new_node->m_next = m_head;
-        m_head->m_prev = new_node;
-        m_head = new_node;
+// Adds a new node to the front of the list, moving the given value into it
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::push_front(T&& value)
+{
+    return emplace_node(nullptr, std::move(value)).second;
+}
+
+// Constructs an element in place at the end of the list and returns a reference to it
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename... Args>
+const T& SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::emplace_back(Args&&... args)
+{
+    return emplace_node(m_tail, std::forward<Args>(args)...).first->m_data;
+}
+
+// Constructs an element in place at the specified position and returns an iterator to it
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename... Args>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::iterator SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::emplace(const int pos, Args&&... args)
+{
+    // Check if the position is out of range
+    if (pos < 0 || pos > m_size) {
+        throw std::out_of_range("Invalid position for emplace");
     }
-    put_in_sorted_order(new_node);
+
+    // Find the node at position (pos - 1), the new node goes right after it
+    node_type* prev = pos == 0 ? nullptr : node_at(pos - 1);
+
+    return iterator(emplace_node(prev, std::forward<Args>(args)...).first, &m_tail);
+}
+
+// Constructs an element in place at the end of the list and returns a sorted iterator to it
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename... Args>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::sorted_iterator SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::emplace_sorted(Args&&... args)
+{
+    return sorted_iterator(emplace_node(m_tail, std::forward<Args>(args)...).first, &m_desc_head);
+}
+
+/* Function constructs a node from the given arguments, links it into the sorted order and into the
+   insertion order after 'prev' (nullptr means at the front). Returns the node holding the key and
+   whether it is the new one, with unique keys a duplicate is released again. */
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename... Args>
+std::pair<typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type*, bool> SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::emplace_node(node_type* prev, Args&&... args)
+{
+    // Create a new node, its value is constructed exactly once inside the node
+    node_type* new_node = create_node(std::forward<Args>(args)...);
+
+    // The sorted search finds an element with the same key on its way
+    node_type* elem = put_in_sorted_order(new_node);
+    if (elem != new_node) {
+        destroy_node(new_node);
+        return std::make_pair(elem, false);
+    }
+
+    link_after(prev, new_node);
     ++m_size;
+    return std::make_pair(new_node, true);
 }
 
 // Function is used to populate a sorted list with a specified number of elements that all have the same given value.
-template <typename T>
-void SelfOrganizingSortedList<T>::assign(const T& value, size_t count)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::assign(const T& value, size_t count)
 {
     // Check if the count is non-positive (including negative)
     if (count <= 0) {
         throw std::runtime_error("Count is negative. Cannot assign()");
     }
 
+    // With unique keys all copies but the first would be rejected
+    if constexpr (UniqueKeys) {
+        count = 1;
+    }
+
     // If the list is not empty, clear it to start with a fresh list
     if (m_head) {
         clear();
     }
 
-    // Loop 'count' times to add 'count' elements with the given value to the list
-    for (int i = 0; i < count; ++i) {
-        push_back(value);
+    try {
+        // Link 'count' nodes with the given value one after another
+        for (size_t i = 0; i < count; ++i) {
+            link_after(m_tail, create_node(value));
+            ++m_size;
+        }
+    } catch (...) {
+        clear();
+        throw;
+    }
+
+    // All keys are equal, so the sorted order is known without comparing:
+    // like repeated push_back, a later node precedes the earlier equal ones
+    std::vector<node_type*> nodes;
+    nodes.reserve(count);
+    for (node_type* cur = m_tail; cur; cur = cur->m_prev) {
+        nodes.push_back(cur);
     }
+    link_sorted_order(nodes);
 }
 
 // Function takes an initializer list of elements and assigns these elements to the list.
-template <typename T>
-void SelfOrganizingSortedList<T>::assign(std::initializer_list<T> init_list)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::assign(std::initializer_list<T> init_list)
 {
-    // Set the size 0
-    m_size = 0;
+    assign(init_list.begin(), init_list.end());
+}
 
-    // Add each element to the end of the sorted list using push_back
-    for (const T& elem : init_list) {
-        push_back(elem);
+// Function replaces the contents with the values of a range, sorting them once instead of inserting one by one.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename InputIt, typename>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::assign(InputIt first, InputIt last)
+{
+    // Start with a fresh list
+    clear();
+
+    try {
+        // Link the insertion order in a single pass
+        for (; first != last; ++first) {
+            link_after(m_tail, create_node(*first));
+            ++m_size;
+        }
+    } catch (...) {
+        clear();
+        throw;
+    }
+
+    // Collect the nodes from the back, so that after a stable sort a later node precedes
+    // the earlier equal ones, exactly as repeated push_back would order them. With unique keys
+    // collect them from the front instead, repeated push_back keeps the first of equal ones.
+    std::vector<node_type*> nodes;
+    nodes.reserve(m_size);
+    if constexpr (UniqueKeys) {
+        for (node_type* cur = m_head; cur; cur = cur->m_next) {
+            nodes.push_back(cur);
+        }
+    } else {
+        for (node_type* cur = m_tail; cur; cur = cur->m_prev) {
+            nodes.push_back(cur);
+        }
+    }
+    std::stable_sort(nodes.begin(), nodes.end(), [this](const node_type* lhs, const node_type* rhs) {
+        return key_less(key_of(lhs), key_of(rhs));
+    });
+
+    // With unique keys, release every node whose key equals the one before it in sorted order
+    if constexpr (UniqueKeys) {
+        size_t kept = 0;
+        for (node_type* elem : nodes) {
+            if (kept > 0 && !key_less(key_of(nodes[kept - 1]), key_of(elem))) {
+                next_link(elem->m_prev, 0) = elem->m_next;
+                prev_link(elem->m_next, 0) = elem->m_prev;
+                destroy_node(elem);
+                --m_size;
+            } else {
+                nodes[kept++] = elem;
+            }
+        }
+
+        // Positions have changed, relink the positional express lanes
+        if (kept < nodes.size()) {
+            nodes.resize(kept);
+            link_insertion_order();
+        }
+    }
+
+    link_sorted_order(nodes);
+}
+
+/* Function replaces the contents with the values of a range like assign(first, last), splitting every step into
+   chunks run on 'threads' threads: the nodes are allocated from one pool per chunk, the keys are sorted by
+   sorting chunks and merging them pairwise, and both chains with their express lanes are linked segment by
+   segment and stitched at the segment boundaries. The result is the same as with a single thread. */
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename ForwardIt, typename>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::assign(ForwardIt first, ForwardIt last, int threads)
+{
+    // Check if the number of threads is valid
+    if (threads < 1) {
+        throw std::runtime_error("threads must be positive");
+    }
+
+    // Small chunks cost more in threads than they save
+    const int n = static_cast<int>(std::distance(first, last));
+    if (threads > n / kMinParallelChunk) {
+        threads = n / kMinParallelChunk;
+    }
+    if (threads <= 1) {
+        assign(first, last);
+        return;
+    }
+
+    // Start with a fresh list
+    clear();
+
+    // Chunk 'c' covers the positions [bounds[c], bounds[c + 1])
+    std::vector<int> bounds(threads + 1);
+    std::vector<ForwardIt> starts(threads, first);
+    for (int chunk = 0; chunk <= threads; ++chunk) {
+        bounds[chunk] = static_cast<int>(static_cast<long long>(n) * chunk / threads);
+        if (chunk > 0 && chunk < threads) {
+            starts[chunk] = std::next(starts[chunk - 1], bounds[chunk] - bounds[chunk - 1]);
+        }
+    }
+
+    // Every chunk allocates from its own pool and draws levels from its own generator
+    std::vector<node_type*> nodes(n, nullptr);
+    std::vector<pool_type> pools(threads);
+    try {
+        run_chunks(threads, [&](int chunk) {
+            unsigned int seed = m_seed ^ (0x9E3779B9u * static_cast<unsigned int>(chunk + 1));
+            if (seed == 0) {
+                seed = 1;
+            }
+            ForwardIt cur = starts[chunk];
+            for (int pos = bounds[chunk]; pos < bounds[chunk + 1]; ++pos, ++cur) {
+                nodes[pos] = pools[chunk].create(draw_level(seed), *cur);
+                cache_key(nodes[pos]);
+            }
+        });
+    } catch (...) {
+        for (int chunk = 0; chunk < threads; ++chunk) {
+            for (int pos = bounds[chunk]; pos < bounds[chunk + 1]; ++pos) {
+                if (nodes[pos]) {
+                    pools[chunk].destroy(nodes[pos]);
+                }
+            }
+        }
+        throw;
+    }
+    for (pool_type& pool : pools) {
+        m_pool.adopt(pool);
+    }
+    SOSL_STATS(m_stats.record_allocations(static_cast<uint64_t>(n));)
+
+    // Sort the positions by key. Equal keys are ordered like assign(first, last) orders them: the later
+    // position first, or with unique keys the first one, which is kept.
+    std::vector<int> order(n);
+    for (int pos = 0; pos < n; ++pos) {
+        order[pos] = UniqueKeys ? pos : n - 1 - pos;
+    }
+    try {
+        parallel_sort(order, [this, &nodes](int lhs, int rhs) {
+            return key_less(key_of(nodes[lhs]), key_of(nodes[rhs]));
+        }, threads);
+    } catch (...) {
+        for (node_type* elem : nodes) {
+            destroy_node(elem);
+        }
+        throw;
+    }
+
+    std::vector<node_type*> sorted(n);
+    if constexpr (UniqueKeys) {
+        // Release every node whose key equals the one before it in sorted order
+        int kept = 0;
+        for (int pos : order) {
+            if (kept > 0 && !key_less(key_of(sorted[kept - 1]), key_of(nodes[pos]))) {
+                destroy_node(nodes[pos]);
+                nodes[pos] = nullptr;
+            } else {
+                sorted[kept++] = nodes[pos];
+            }
+        }
+        if (kept < n) {
+            sorted.resize(kept);
+            nodes.erase(std::remove(nodes.begin(), nodes.end(), nullptr), nodes.end());
+        }
+    } else {
+        run_chunks(threads, [&](int chunk) {
+            for (int pos = bounds[chunk]; pos < bounds[chunk + 1]; ++pos) {
+                sorted[pos] = nodes[order[pos]];
+            }
+        });
     }
+
+    link_insertion_order(nodes, threads);
+    link_sorted_order(sorted, threads);
+    m_size = static_cast<int>(nodes.size());
 }
 
 // The function adjusts the size of the sorted list to the specified count
-template <typename T>
-void SelfOrganizingSortedList<T>::resize(size_t count)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::resize(size_t count)
 {
     // Check if the count is non-positive (including negative)
     if (count <= 0) {
@@ -213,7 +560,10 @@ void SelfOrganizingSortedList<T>::resize(size_t count)
 
     // Increase the size of the list by adding default-initialized elements
     while (this->size() < count) {
-        push_back(T{});
+        // With unique keys a second default value is rejected, stop there
+        if (!push_back(T{})) {
+            break;
+        }
     }
 
     // Decrease the size of the list by removing elements from the end
@@ -223,8 +573,8 @@ void SelfOrganizingSortedList<T>::resize(size_t count)
 }
 
 // 
-template <typename T>
-void SelfOrganizingSortedList<T>::emplace_front(size_t count)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::emplace_front(size_t count)
 {
     // Check if the count is non-positive (including negative)
     if (count <= 0) {
@@ -233,7 +583,10 @@ void SelfOrganizingSortedList<T>::emplace_front(size_t count)
 
     // Increase the size of the list by adding default-initialized elements
     while (this->size() < count) {
-        push_front(T{});
+        // With unique keys a second default value is rejected, stop there
+        if (!push_front(T{})) {
+            break;
+        }
     }
 
     // Decrease the size of the list by removing elements from the front
@@ -243,255 +596,966 @@ void SelfOrganizingSortedList<T>::emplace_front(size_t count)
 } 
 
 /* Function is responsible for inserting a new node with the given value into 
-   the sorted list while maintaining both ascending and descending order pointers */
-template <typename T>
-void SelfOrganizingSortedList<T>::put_in_sorted_order(Node<T>* new_node)
+   the sorted list while maintaining both ascending and descending order pointers. Returns the node
+   now holding the key: the new node, or with unique keys an existing node with the same key, in
+   which case the new node is left unlinked */
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type* SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::put_in_sorted_order(node_type* new_node)
 {
     // Check if the new_node is null (nothing to sort)
     if (!new_node) {
-        return;
+        return nullptr;
+    }
+
+    // Find the last node that is less than the new one, near the finger or through the express lanes
+    SearchCost cost;
+    node_type* prev = locate_sorted_predecessor(key_of(new_node), cost);
+
+    // With unique keys, the node right after the predecessor is the only one that can have the same key
+    if constexpr (UniqueKeys) {
+        node_type* next = greater_link(prev, 0);
+        if (next && !search_less(key_of(new_node), key_of(next), cost)) {
+            SOSL_STATS(m_stats.record_search(cost);)
+            return next;
+        }
+    }
+    SOSL_STATS(m_stats.record_search(cost);)
+
+    // Link the new node after 'prev' on the sorted chain and on each of its express lanes.
+    // The predecessor on level 'i' is the nearest node at or before the predecessor
+    // on level 'i - 1' that takes part in level 'i'.
+    for (int level = 0; level <= new_node->m_level; ++level) {
+        while (prev && prev->m_level < level) {
+            prev = lesser_link(prev, level - 1);
+        }
+
+        node_type* next = greater_link(prev, level);
+        greater_link(new_node, level) = next;
+        lesser_link(new_node, level) = prev;
+        greater_link(prev, level) = new_node;
+        lesser_link(next, level) = new_node;
+    }
+
+    // Raise the search level if the new node is the tallest one
+    if (new_node->m_level > m_level) {
+        m_level = new_node->m_level;
     }
 
-    // If the ascending and descending heads are not set, this is the first node
+    // The next insertion is likely to land close to this one
+    m_finger = new_node;
+    return new_node;
+}
+
+/* Function returns the last node in sorted order whose value is less than the given value, trying
+   the cheap entry points first: the largest element (m_desc_head), the smallest one (m_asc_head) and
+   a few steps around the last inserted node (the finger). Only if none of them is close enough the
+   search descends the express lanes. */
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type* SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::locate_sorted_predecessor(key_arg key, SearchCost& cost) const
+{
     if (!m_asc_head) {
-        m_asc_head = new_node;
-        m_desc_head = new_node;
-        return;
+        return nullptr;
     }
 
-    Node<T>* cur = m_asc_head;
-    Node<T>* prev = nullptr;
+    // A new maximum goes after m_desc_head, a new minimum before m_asc_head
+    if (search_less(key_of(m_desc_head), key, cost)) {
+        return m_desc_head;
+    }
+    if (!search_less(key_of(m_asc_head), key, cost)) {
+        return nullptr;
+    }
 
-    // Traverse the list in ascending order until we find the appropriate position
-    while (cur && cur->m_data < new_node->m_data) {
-        prev = cur;
-        cur = cur->m_greater;
+    if (m_finger) {
+        node_type* cur = m_finger;
+        if (search_less(key_of(cur), key, cost)) {
+            // The position is after the finger, walk a few steps towards greater values
+            for (int step = 0; step < kFingerSteps; ++step) {
+                node_type* next = cur->m_greater;
+                if (!next || !search_less(key_of(next), key, cost)) {
+                    return cur;
+                }
+                SOSL_STATS(++cost.m_hops;)
+                cur = next;
+            }
+        } else {
+            // The position is before the finger, walk a few steps towards lesser values
+            for (int step = 0; step < kFingerSteps; ++step) {
+                node_type* prev = cur->m_lesser;
+                SOSL_STATS(++cost.m_hops;)
+                if (!prev || search_less(key_of(prev), key, cost)) {
+                    return prev;
+                }
+                cur = prev;
+            }
+        }
     }
 
-    // Update the 'greater' pointer of the previous node
-    if (prev) {
-        prev->m_greater = new_node;
+    // Too far from every entry point, descend the express lanes
+    return find_sorted_predecessor(key, cost);
+}
+
+// Function returns the last node in sorted order whose value is less than the given value.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type* SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::find_sorted_predecessor(key_arg key, SearchCost& cost) const
+{
+    node_type* prev = nullptr;
+
+    // Descend from the highest express lane down to the sorted chain (level 0)
+    for (int level = m_level; level >= 0; --level) {
+        node_type* cur = greater_link(prev, level);
+
+        // Move forward on this level while the nodes are still less than the value
+        while (cur && search_less(key_of(cur), key, cost)) {
+            SOSL_STATS(++cost.m_hops;)
+            prev = cur;
+            cur = greater_link(cur, level);
+        }
+    }
+    return prev;
+}
+
+// Function returns the last node in sorted order whose value is not greater than the given value.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type* SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::find_sorted_last_not_greater(key_arg key, SearchCost& cost) const
+{
+    node_type* prev = nullptr;
+
+    // Descend from the highest express lane down to the sorted chain (level 0)
+    for (int level = m_level; level >= 0; --level) {
+        node_type* cur = greater_link(prev, level);
+
+        // Move forward on this level while the nodes are not greater than the value
+        while (cur && !search_less(key, key_of(cur), cost)) {
+            SOSL_STATS(++cost.m_hops;)
+            prev = cur;
+            cur = greater_link(cur, level);
+        }
+    }
+    return prev;
+}
+
+// Function returns the key a node is ordered by: the cached projection, or the data itself.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+const typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::key_type& SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::key_of(const node_type* elem) const
+{
+    if constexpr (std::is_void<cached_key_type>::value) {
+        return elem->m_data;
     } else {
-        // If there was no previous node, this is the new head in ascending order
-        m_asc_head = new_node;
+        return elem->m_key;
     }
+}
+
+// Function stores the projected key of a new node, nothing is stored without a projection.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::cache_key(node_type* elem)
+{
+    if constexpr (!std::is_void<cached_key_type>::value) {
+        elem->m_key = m_projection(static_cast<const T&>(elem->m_data));
+    }
+}
 
-    // Update the 'lesser' pointer of the current node (if it exists)
-    if (cur) {
-        cur->m_lesser = new_node;
+// Function checks whether 'lhs' is ordered before 'rhs'. Arithmetic keys under the default ordering
+// are compared directly and passed by value, so the search loops compile to plain register compares.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::key_less(key_arg lhs, key_arg rhs) const
+{
+    if constexpr (kDirectCompare) {
+        return lhs < rhs;
     } else {
-        // If there was no current node, this is the new head in descending order
-        m_desc_head = new_node;
+        return m_compare(lhs, rhs);
+    }
+}
+
+// Function compares two keys like key_less(), counting the comparison for a sorted search.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::search_less(key_arg lhs, key_arg rhs, SearchCost& cost) const
+{
+    SOSL_STATS(++cost.m_comparisons;)
+    (void)cost;
+    return key_less(lhs, rhs);
+}
+
+// Function checks whether two keys are equivalent, i.e. neither is ordered before the other.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::key_equal(key_arg lhs, key_arg rhs) const
+{
+    return !key_less(lhs, rhs) && !key_less(rhs, lhs);
+}
+
+// Function returns the 'greater' link of a node at the given level. A null node stands for the
+// list itself, whose 'greater' link is the first node of that level.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type*& SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::greater_link(node_type* elem, int level)
+{
+    if (!elem) {
+        return level == 0 ? m_asc_head : m_lane_heads[level - 1].m_greater;
+    }
+    return level == 0 ? elem->m_greater : elem->m_lanes[level - 1].m_greater;
+}
+
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type* SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::greater_link(node_type* elem, int level) const
+{
+    if (!elem) {
+        return level == 0 ? m_asc_head : m_lane_heads[level - 1].m_greater;
+    }
+    return level == 0 ? elem->m_greater : elem->m_lanes[level - 1].m_greater;
+}
+
+// Function returns the 'lesser' link of a node at the given level. A null node stands for the
+// list itself, whose 'lesser' link is the last node of that level.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type*& SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::lesser_link(node_type* elem, int level)
+{
+    if (!elem) {
+        return level == 0 ? m_desc_head : m_lane_heads[level - 1].m_lesser;
+    }
+    return level == 0 ? elem->m_lesser : elem->m_lanes[level - 1].m_lesser;
+}
+
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type* SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::lesser_link(node_type* elem, int level) const
+{
+    if (!elem) {
+        return level == 0 ? m_desc_head : m_lane_heads[level - 1].m_lesser;
+    }
+    return level == 0 ? elem->m_lesser : elem->m_lanes[level - 1].m_lesser;
+}
+
+// Function draws the number of express lanes for a new node, each level with probability 1/4.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+int SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::random_level()
+{
+    return draw_level(m_seed);
+}
+
+// Function advances a level generator and draws a level from it, each further lane with probability 1/4.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+int SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::draw_level(unsigned int& seed)
+{
+    // xorshift32 step
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    // Every pair of zero bits promotes the node one level higher
+    int level = 0;
+    unsigned int bits = seed;
+    while ((bits & 3u) == 0 && level < kMaxLevel) {
+        ++level;
+        bits >>= 2;
+    }
+    return level;
+}
+
+// Function allocates a new node together with its express lanes from the pool.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename... Args>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type* SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::create_node(Args&&... args)
+{
+    node_type* new_node = m_pool.create(random_level(), std::forward<Args>(args)...);
+    try {
+        cache_key(new_node);
+    } catch (...) {
+        m_pool.destroy(new_node);
+        throw;
+    }
+    SOSL_STATS(m_stats.record_allocations(1);)
+    return new_node;
+}
+
+// Function returns a node together with its express lanes to the pool.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::destroy_node(node_type* elem)
+{
+    SOSL_STATS(m_stats.record_frees(1);)
+    m_pool.destroy(elem);
+}
+
+// Function removes a node from both orders and releases it.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::erase_node(node_type* elem)
+{
+    unlink(elem);
+    remove_sorted_node(elem);
+
+    destroy_node(elem);
+    --m_size;
+}
+
+// Function forgets all express lanes and the finger, used once the nodes have been released or handed over.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::reset_lanes()
+{
+    for (int i = 0; i < kMaxLevel; ++i) {
+        m_lane_heads[i] = lane_type();
+    }
+    m_level = 0;
+    m_finger = nullptr;
+}
+
+// Function rebuilds the sorted chain and its express lanes from nodes given in ascending order.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::link_sorted_order(const std::vector<node_type*>& nodes)
+{
+    // Link the sorted chain
+    node_type* last = nullptr;
+    for (node_type* elem : nodes) {
+        elem->m_lesser = last;
+        greater_link(last, 0) = elem;
+        last = elem;
+    }
+    greater_link(last, 0) = nullptr;
+    m_desc_head = last;
+
+    link_sorted_lanes();
+}
+
+// Function rebuilds the sorted express lanes in one pass over the sorted chain.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::link_sorted_lanes()
+{
+    m_level = 0;
+
+    // Last node linked on every level so far, nullptr stands for the list head
+    node_type* last[kMaxLevel + 1] = {};
+
+    for (node_type* elem = m_asc_head; elem; elem = elem->m_greater) {
+        for (int level = 1; level <= elem->m_level; ++level) {
+            lesser_link(elem, level) = last[level];
+            greater_link(last[level], level) = elem;
+            last[level] = elem;
+        }
+        if (elem->m_level > m_level) {
+            m_level = elem->m_level;
+        }
+    }
+
+    // Close every level at its last node
+    for (int level = 1; level <= kMaxLevel; ++level) {
+        greater_link(last[level], level) = nullptr;
+        lesser_link(nullptr, level) = last[level];
+    }
+}
+
+/* Function links the sorted chain and its express lanes from nodes given in ascending order. Every chunk
+   links its own segment, the segments are then stitched at their boundaries on every level. */
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::link_sorted_order(const std::vector<node_type*>& nodes, int threads)
+{
+    const int n = static_cast<int>(nodes.size());
+    if (threads > n) {
+        threads = n;
+    }
+    if (threads <= 1) {
+        link_sorted_order(nodes);
+        return;
+    }
+
+    std::vector<SegmentEnds> ends(threads);
+    run_chunks(threads, [&](int chunk) {
+        const int begin = static_cast<int>(static_cast<long long>(n) * chunk / threads);
+        const int end = static_cast<int>(static_cast<long long>(n) * (chunk + 1) / threads);
+        SegmentEnds& segment = ends[chunk];
+        for (int level = 1; level <= kMaxLevel; ++level) {
+            segment.m_first[level] = nullptr;
+            segment.m_last[level] = nullptr;
+        }
+        segment.m_level = 0;
+
+        for (int pos = begin; pos < end; ++pos) {
+            // The neighbours on the sorted chain are read from the array, even across the segment boundary
+            node_type* elem = nodes[pos];
+            elem->m_lesser = pos > 0 ? nodes[pos - 1] : nullptr;
+            elem->m_greater = pos + 1 < n ? nodes[pos + 1] : nullptr;
+
+            for (int level = 1; level <= elem->m_level; ++level) {
+                if (segment.m_last[level]) {
+                    greater_link(segment.m_last[level], level) = elem;
+                    lesser_link(elem, level) = segment.m_last[level];
+                } else {
+                    segment.m_first[level] = elem;
+                }
+                segment.m_last[level] = elem;
+            }
+            if (elem->m_level > segment.m_level) {
+                segment.m_level = elem->m_level;
+            }
+        }
+    });
+    m_asc_head = nodes.front();
+    m_desc_head = nodes.back();
+
+    // Stitch the segments on every express level, nullptr stands for the list head
+    node_type* last[kMaxLevel + 1] = {};
+    m_level = 0;
+    for (const SegmentEnds& segment : ends) {
+        for (int level = 1; level <= segment.m_level; ++level) {
+            if (segment.m_first[level]) {
+                greater_link(last[level], level) = segment.m_first[level];
+                lesser_link(segment.m_first[level], level) = last[level];
+                last[level] = segment.m_last[level];
+            }
+        }
+        if (segment.m_level > m_level) {
+            m_level = segment.m_level;
+        }
+    }
+
+    // Close every level at its last node
+    for (int level = 1; level <= kMaxLevel; ++level) {
+        greater_link(last[level], level) = nullptr;
+        lesser_link(nullptr, level) = last[level];
+    }
+}
+
+// Function returns the 'next' link of a node at the given level. A null node stands for the
+// list itself, whose 'next' link is the first node of that level.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type*& SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::next_link(node_type* elem, int level)
+{
+    if (!elem) {
+        return level == 0 ? m_head : m_lane_heads[level - 1].m_next;
+    }
+    return level == 0 ? elem->m_next : elem->m_lanes[level - 1].m_next;
+}
+
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type* SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::next_link(node_type* elem, int level) const
+{
+    if (!elem) {
+        return level == 0 ? m_head : m_lane_heads[level - 1].m_next;
+    }
+    return level == 0 ? elem->m_next : elem->m_lanes[level - 1].m_next;
+}
+
+// Function returns the 'prev' link of a node at the given level. A null node stands for the
+// list itself, whose 'prev' link is the last node of that level.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type*& SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::prev_link(node_type* elem, int level)
+{
+    if (!elem) {
+        return level == 0 ? m_tail : m_lane_heads[level - 1].m_prev;
+    }
+    return level == 0 ? elem->m_prev : elem->m_lanes[level - 1].m_prev;
+}
+
+// Function returns the number of insertion chain steps covered by the 'next' link of a node
+// at the given express level (1 and above). The list itself stands at position -1.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+int& SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::span_link(node_type* elem, int level)
+{
+    return elem ? elem->m_lanes[level - 1].m_span : m_lane_heads[level - 1].m_span;
+}
+
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+int SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::span_link(node_type* elem, int level) const
+{
+    return elem ? elem->m_lanes[level - 1].m_span : m_lane_heads[level - 1].m_span;
+}
+
+// Function returns the node at the given position, skipping along the express lanes.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type* SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_at(int pos) const
+{
+    node_type* cur = nullptr;
+    int cur_pos = -1;
+    SOSL_STATS(uint64_t steps = 0;)
+
+    // Descend from the highest express lane, never stepping past the wanted position
+    for (int level = m_level; level > 0; --level) {
+        node_type* next = next_link(cur, level);
+        while (next && cur_pos + span_link(cur, level) <= pos) {
+            SOSL_STATS(++steps;)
+            cur_pos += span_link(cur, level);
+            cur = next;
+            next = next_link(cur, level);
+        }
+    }
+
+    // Finish on the insertion chain itself
+    SOSL_STATS(steps += static_cast<uint64_t>(pos - cur_pos);)
+    while (cur_pos < pos) {
+        cur = next_link(cur, 0);
+        ++cur_pos;
+    }
+
+    SOSL_STATS(m_stats.record_walk(steps);)
+    return cur;
+}
+
+// Function links a node into the insertion order right after 'prev' (nullptr means at the front)
+// and updates the positional express lanes.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::link_after(node_type* prev, node_type* elem)
+{
+    // Link on the insertion chain
+    node_type* next = next_link(prev, 0);
+    elem->m_prev = prev;
+    elem->m_next = next;
+    next_link(prev, 0) = elem;
+    prev_link(next, 0) = elem;
+
+    // Walk back to the predecessor on every level, counting how far it is from 'elem'
+    const int top = elem->m_level > m_level ? elem->m_level : m_level;
+    node_type* before = prev;
+    int distance = 1;
+    for (int level = 1; level <= top; ++level) {
+        while (before && before->m_level < level) {
+            node_type* lower = prev_link(before, level - 1);
+            distance += level == 1 ? 1 : span_link(lower, level - 1);
+            before = lower;
+        }
+
+        if (level <= elem->m_level) {
+            // 'elem' takes part in this level, split the link of its predecessor
+            node_type* after = next_link(before, level);
+            next_link(elem, level) = after;
+            prev_link(elem, level) = before;
+            span_link(elem, level) = after ? span_link(before, level) - distance + 1 : 0;
+            span_link(before, level) = distance;
+            next_link(before, level) = elem;
+            prev_link(after, level) = elem;
+        } else if (!next) {
+            // Appended at the end, no higher link passes over 'elem'
+            break;
+        } else if (next_link(before, level)) {
+            // The link of the predecessor passes over 'elem' and now covers one more step
+            ++span_link(before, level);
+        }
+    }
+}
+
+// Function unlinks a node from the insertion order and updates the positional express lanes.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::unlink(node_type* elem)
+{
+    const int top = elem->m_level > m_level ? elem->m_level : m_level;
+    node_type* before = elem;
+    for (int level = 1; level <= top; ++level) {
+        if (level <= elem->m_level) {
+            // 'elem' takes part in this level, join the links around it
+            before = prev_link(elem, level);
+            node_type* after = next_link(elem, level);
+            span_link(before, level) = after ? span_link(before, level) + span_link(elem, level) - 1 : 0;
+            next_link(before, level) = after;
+            prev_link(after, level) = before;
+        } else if (!elem->m_next) {
+            // 'elem' is the tail, no higher link passes over it
+            break;
+        } else {
+            // Find the predecessor on this level, its link passes over 'elem' if it has one
+            while (before && before->m_level < level) {
+                before = prev_link(before, level - 1);
+            }
+            if (next_link(before, level)) {
+                --span_link(before, level);
+            }
+        }
     }
 
-    // Update the 'lesser' and 'greater' pointers of the new_node
-    new_node->m_lesser = prev;
-    new_node->m_greater = cur;
+    // Unlink from the insertion chain
+    next_link(elem->m_prev, 0) = elem->m_next;
+    prev_link(elem->m_next, 0) = elem->m_prev;
+}
+
+// Function rebuilds the positional express lanes in one pass over the insertion chain.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::link_insertion_order()
+{
+    // Last node linked on every level so far and its position, nullptr stands for the list head
+    node_type* last[kMaxLevel + 1] = {};
+    int last_pos[kMaxLevel + 1];
+    for (int level = 0; level <= kMaxLevel; ++level) {
+        last_pos[level] = -1;
+    }
+
+    int pos = 0;
+    for (node_type* cur = m_head; cur; cur = cur->m_next, ++pos) {
+        for (int level = 1; level <= cur->m_level; ++level) {
+            next_link(last[level], level) = cur;
+            prev_link(cur, level) = last[level];
+            span_link(last[level], level) = pos - last_pos[level];
+            last[level] = cur;
+            last_pos[level] = pos;
+        }
+    }
+
+    // Close every level at its last node
+    for (int level = 1; level <= kMaxLevel; ++level) {
+        next_link(last[level], level) = nullptr;
+        span_link(last[level], level) = 0;
+        prev_link(nullptr, level) = last[level];
+    }
+}
+
+/* Function links the insertion chain and its positional express lanes from nodes given in insertion order.
+   Every chunk links its own segment, the segments are then stitched at their boundaries on every level. */
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::link_insertion_order(const std::vector<node_type*>& nodes, int threads)
+{
+    const int n = static_cast<int>(nodes.size());
+    if (threads > n) {
+        threads = n;
+    }
+    if (n == 0) {
+        m_head = nullptr;
+        m_tail = nullptr;
+        return;
+    }
+
+    std::vector<SegmentEnds> ends(threads);
+    run_chunks(threads, [&](int chunk) {
+        const int begin = static_cast<int>(static_cast<long long>(n) * chunk / threads);
+        const int end = static_cast<int>(static_cast<long long>(n) * (chunk + 1) / threads);
+        SegmentEnds& segment = ends[chunk];
+        for (int level = 1; level <= kMaxLevel; ++level) {
+            segment.m_first[level] = nullptr;
+            segment.m_last[level] = nullptr;
+        }
+        segment.m_level = 0;
+
+        for (int pos = begin; pos < end; ++pos) {
+            // The neighbours on the insertion chain are read from the array, even across the segment boundary
+            node_type* elem = nodes[pos];
+            elem->m_prev = pos > 0 ? nodes[pos - 1] : nullptr;
+            elem->m_next = pos + 1 < n ? nodes[pos + 1] : nullptr;
+
+            for (int level = 1; level <= elem->m_level; ++level) {
+                if (segment.m_last[level]) {
+                    next_link(segment.m_last[level], level) = elem;
+                    prev_link(elem, level) = segment.m_last[level];
+                    span_link(segment.m_last[level], level) = pos - segment.m_last_pos[level];
+                } else {
+                    segment.m_first[level] = elem;
+                    segment.m_first_pos[level] = pos;
+                }
+                segment.m_last[level] = elem;
+                segment.m_last_pos[level] = pos;
+            }
+            if (elem->m_level > segment.m_level) {
+                segment.m_level = elem->m_level;
+            }
+        }
+    });
+    m_head = nodes.front();
+    m_tail = nodes.back();
+
+    // Stitch the segments on every express level, nullptr stands for the list head at position -1
+    node_type* last[kMaxLevel + 1] = {};
+    int last_pos[kMaxLevel + 1];
+    for (int level = 0; level <= kMaxLevel; ++level) {
+        last_pos[level] = -1;
+    }
+    for (const SegmentEnds& segment : ends) {
+        for (int level = 1; level <= segment.m_level; ++level) {
+            if (segment.m_first[level]) {
+                next_link(last[level], level) = segment.m_first[level];
+                prev_link(segment.m_first[level], level) = last[level];
+                span_link(last[level], level) = segment.m_first_pos[level] - last_pos[level];
+                last[level] = segment.m_last[level];
+                last_pos[level] = segment.m_last_pos[level];
+            }
+        }
+    }
+
+    // Close every level at its last node
+    for (int level = 1; level <= kMaxLevel; ++level) {
+        next_link(last[level], level) = nullptr;
+        span_link(last[level], level) = 0;
+        prev_link(nullptr, level) = last[level];
+    }
 }
 
 // Function allows inserting a new element with the given value at a specified position.
-template <typename T>
-void SelfOrganizingSortedList<T>::insert(const T& value, const int pos)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::insert(const T& value, const int pos)
 {
     // Check if the position is out of range
     if (pos < 0 || pos > m_size) {
         throw std::out_of_range("Invalid position for insert");
     }
 
-    // If inserting at the beginning (position 0), use push_front
-    if (pos == 0) {
-        push_front(value);
-    } 
-    // If inserting at the end (position equal to current size), use push_back
-    else if (pos == m_size) {
-        push_back(value);
-    } 
-    // Insert at a specific position within the list
-    else {
-        Node<T>* new_node = new Node<T>(value);
-        Node<T>* cur = m_head;
+    return emplace_node(pos == 0 ? nullptr : node_at(pos - 1), value).second;
+}
 
-        // Traverse the list to find the node at position (pos - 1)
-        for (int i = 0; i < pos - 1; ++i) {
-            cur = cur->m_next;
-        }
+// Function allows inserting a new element with an rvalue reference (T&&) at a specified position.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::insert(T&& value, const int pos)
+{
+    // Check if the position is out of range
+    if (pos < 0 || pos > m_size) {
+        throw std::out_of_range("Invalid position for insert");
+    }
 
-        // Update pointers to insert the new node
-        new_node->m_prev = cur;
-        new_node->m_next = cur->m_next;
-        cur->m_next->m_prev = new_node;
-        cur->m_next = new_node;
+    // Move the value into the node
+    return emplace_node(pos == 0 ? nullptr : node_at(pos - 1), std::move(value)).second;
+}
+
+// Function allows inserting multiple elements with the same value at a specified position.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::insert(const T& value, const int pos, const int count)
+{
+    // Check if the position is out of range or count is negative
+    if (pos < 0 || pos > m_size || count < 0) {
+        throw std::out_of_range("Invalid position for insert or non valid count");
+    }
 
-        // Ensure the list remains sorted with the new node
-        put_in_sorted_order(new_node);
+    // Find the node at position (pos - 1) once, all new nodes go right after it
+    node_type* prev = pos == 0 ? nullptr : node_at(pos - 1);
 
-        ++m_size;
+    for (int i = 0; i < count; ++i) {
+        // With unique keys every copy after the first is rejected
+        if (!emplace_node(prev, value).second) {
+            break;
+        }
     }
 }
 
-// Function allows inserting a new element with an rvalue reference (T&&) at a specified position.
-template <typename T>
-void SelfOrganizingSortedList<T>::insert(T&& value, const int pos)
+// Function adds the values of a range to the end of the insertion order, merging them into the sorted order at once.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename InputIt, typename>
+int SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::push_back_batch(InputIt first, InputIt last)
+{
+    return emplace_batch(m_tail, first, last);
+}
+
+// Function inserts the values of a range at a position of the insertion order, merging them into the sorted order at once.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename InputIt, typename>
+int SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::insert_batch(const int pos, InputIt first, InputIt last)
 {
     // Check if the position is out of range
     if (pos < 0 || pos > m_size) {
-        throw std::out_of_range("Invalid position for insert");
+        throw std::out_of_range("Invalid position for insert_batch");
     }
 
-    // Create a new node with the moved value (using std::move)
-    Node<T>* new_node = new Node<T>(std::move(value)); // Move the value into the node
+    return emplace_batch(pos == 0 ? nullptr : node_at(pos - 1), first, last);
+}
 
-    // If inserting at the beginning (position 0), use push_front
-    if (pos == 0) { 
-        push_front(new_node->m_data);
-    } 
-    // If inserting at the end (position equal to current size), use push_back
-    else if (pos == m_size) {
-        push_back(new_node->m_data);
-    } 
-    // Insert at a specific position within the list
-    else { 
-        Node<T>* cur = m_head;
+/* Function appends the values parsed from a stream, chunk_size values at a time. Every chunk is added with
+   push_back_batch() while the next one is parsed on another thread, so besides the list only two chunks are
+   held in memory. parser(in, value) reads one value and returns false at the end of the input.
+   Returns the number of values added. */
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename Parser>
+int SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::ingest(std::istream& in, Parser parser, int chunk_size)
+{
+    // Check if the chunk size is valid
+    if (chunk_size < 1) {
+        throw std::runtime_error("chunk_size must be positive");
+    }
 
-        // Traverse the list to find the node at position (pos - 1)
-        for (int i = 0; i < pos - 1; ++i) {
-            cur = cur->m_next;
+    // Only one chunk is read at a time, so the stream and the parser are never shared
+    auto read_chunk = [&in, &parser, chunk_size](std::vector<T>& chunk) {
+        chunk.clear();
+        T value;
+        while (static_cast<int>(chunk.size()) < chunk_size && parser(in, value)) {
+            chunk.push_back(std::move(value));
+        }
+    };
+
+    std::vector<T> current;
+    std::vector<T> next;
+    current.reserve(chunk_size);
+    next.reserve(chunk_size);
+    read_chunk(current);
+
+    int added = 0;
+    while (!current.empty()) {
+        // A short chunk means the input is exhausted
+        const bool more = static_cast<int>(current.size()) == chunk_size;
+        std::future<void> reading;
+        if (more) {
+            reading = std::async(std::launch::async, read_chunk, std::ref(next));
         }
 
-        // Update pointers to insert the new node
-        new_node->m_prev = cur;
-        new_node->m_next = cur->m_next;
-        cur->m_next->m_prev = new_node;
-        cur->m_next = new_node;
-
-        // Ensure the list remains sorted with the new node
-        put_in_sorted_order(new_node);
+        try {
+            added += push_back_batch(std::make_move_iterator(current.begin()), std::make_move_iterator(current.end()));
+        } catch (...) {
+            if (reading.valid()) {
+                reading.wait();
+            }
+            throw;
+        }
 
-        ++m_size;
+        if (!more) {
+            break;
+        }
+        reading.get();
+        current.swap(next);
     }
+    return added;
 }
 
-// Function allows inserting multiple elements with the same value at a specified position.
-template <typename T>
-void SelfOrganizingSortedList<T>::insert(const T& value, const int pos, const int count)
+/* Function creates a node for every value of a range and links them after 'prev' in their order.
+   A batch that is large next to the list is sorted and merged into the sorted chain in one sweep
+   (O(k log k + n)), a small one is inserted node by node through the express lanes (O(k log n)).
+   Returns the number of values added, with unique keys the repeated ones are dropped. */
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename InputIt>
+int SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::emplace_batch(node_type* prev, InputIt first, InputIt last)
 {
-    // Check if the position is out of range or count is negative
-    if (pos < 0 || pos > m_size || count < 0) {
-        throw std::out_of_range("Invalid position for insert or non valid count");
-    }
-
-    // If inserting at the beginning (position 0), use push_front multiple times
-    if (pos == 0) {
-        for (int i = 0; i < count; ++i) {
-            push_front(value);
+    // Create all nodes first, so that a failure leaves the list untouched
+    std::vector<node_type*> batch;
+    try {
+        for (; first != last; ++first) {
+            batch.push_back(create_node(*first));
         }
-    } else if (pos == m_size) { // If inserting at the end (position equal to current size), use push_back multiple times
-        for (int i = 0; i < count; ++i) {
-            push_back(value);
+    } catch (...) {
+        for (node_type* elem : batch) {
+            destroy_node(elem);
         }
-    } else { // Insert at a specific position within the list, multiple times
-        for (int i = 0; i < count; ++i) {
-            Node<T>* new_node = new Node<T>(value);
-            Node<T>* cur = m_head;
+        throw;
+    }
 
-            // Traverse the list to find the node at position (pos - 1)
-            for (int i = 0; i < pos - 1; ++i) {
-                cur = cur->m_next;
-            }
+    // log2 of the list size, the cost of one search through the express lanes
+    int depth = 0;
+    for (int n = m_size; n > 0; n >>= 1) {
+        ++depth;
+    }
 
-            new_node->m_prev = cur;
-            new_node->m_next = cur->m_next;
-            cur->m_next->m_prev = new_node;
-            cur->m_next = new_node;
+    if (static_cast<long long>(batch.size()) * depth >= m_size) {
+        // Dropped nodes are replaced by nullptr
+        merge_batch(batch);
+    } else {
+        for (node_type*& elem : batch) {
+            if (put_in_sorted_order(elem) != elem) {
+                destroy_node(elem);
+                elem = nullptr;
+            }
+        }
+    }
 
-            put_in_sorted_order(new_node);
+    // Link the remaining nodes into the insertion order one after another
+    int added = 0;
+    for (node_type* elem : batch) {
+        if (elem) {
+            link_after(prev, elem);
+            prev = elem;
+            ++added;
+        }
+    }
+    m_size += added;
+    return added;
+}
 
-            ++m_size;
+/* Function sorts unlinked nodes and merges them into the sorted chain in a single sweep, then
+   relinks the sorted express lanes. Equal nodes end up as if they had been pushed one by one: a
+   later node precedes the earlier ones. With unique keys a node whose key is already present, in
+   the list or earlier in the batch, is released and its entry set to nullptr. */
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::merge_batch(std::vector<node_type*>& batch)
+{
+    // Sort the positions in the batch by key, ties by position: later first, or first kept with unique keys
+    std::vector<size_t> order(batch.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    try {
+        std::sort(order.begin(), order.end(), [this, &batch](size_t lhs, size_t rhs) {
+            if (key_less(key_of(batch[lhs]), key_of(batch[rhs]))) {
+                return true;
+            }
+            if (key_less(key_of(batch[rhs]), key_of(batch[lhs]))) {
+                return false;
+            }
+            return UniqueKeys ? lhs < rhs : lhs > rhs;
+        });
+    } catch (...) {
+        for (node_type* elem : batch) {
+            destroy_node(elem);
+        }
+        throw;
+    }
+
+    // Merge with two fingers. On ties the batch node goes first, as if pushed after ours.
+    node_type* mine = m_asc_head;
+    size_t next_theirs = 0;
+    node_type* last = nullptr;
+    while (mine || next_theirs < order.size()) {
+        node_type* next = nullptr;
+        if (next_theirs == order.size()) {
+            next = mine;
+            mine = mine->m_greater;
+        } else {
+            node_type*& theirs = batch[order[next_theirs]];
+            if (mine && key_less(key_of(mine), key_of(theirs))) {
+                next = mine;
+                mine = mine->m_greater;
+            } else {
+                ++next_theirs;
+
+                // With unique keys only the first node of a key is linked
+                if constexpr (UniqueKeys) {
+                    if ((last && !key_less(key_of(last), key_of(theirs))) || (mine && !key_less(key_of(theirs), key_of(mine)))) {
+                        destroy_node(theirs);
+                        theirs = nullptr;
+                        continue;
+                    }
+                }
+                next = theirs;
+            }
         }
+        next->m_lesser = last;
+        greater_link(last, 0) = next;
+        last = next;
     }
+    greater_link(last, 0) = nullptr;
+    m_desc_head = last;
+
+    // Relink the sorted express lanes over the merged chain
+    link_sorted_lanes();
 }
 
 // Function allows removing an element at a specified position.
-template <typename T>
-void SelfOrganizingSortedList<T>::erase(int pos)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::erase(int pos)
 {
     // Check if the position is out of range
     if (pos < 0 || pos >= m_size) {
         throw std::out_of_range("Invalid position for erase");
     }
 
-    // If erasing at the beginning (position 0), use pop_front
-    if (pos == 0) {
-        pop_front();
-    }
-    // If erasing at the end (position equal to current size - 1), use pop_back 
-    else if (pos == m_size - 1) {
-        pop_back();
-    }
-    // Erase at a specific position within the list
-    else {
-        Node<T>* current = m_head;
-
-        // Traverse the list to find the node at the specified position
-        for (int i = 0; i < pos; ++i) {
-            current = current->m_next;
-        }
-
-        // Update pointers to remove the current node
-        current->m_prev->m_next = current->m_next;
-        current->m_next->m_prev = current->m_prev;
+    // Find the node at the specified position
+    node_type* current = node_at(pos);
 
-        // Remove the current node from sorted order
-        remove_sorted_node(current);
+    // Remove the current node from both orders
+    unlink(current);
+    remove_sorted_node(current);
 
-        delete current;
-        --m_size;
-    }
+    destroy_node(current);
+    --m_size;
 }
 
-// Function allows removing multiple elements at a specified position.
-template <typename T>
-void SelfOrganizingSortedList<T>::erase(int pos, int count)
+// Function allows removing multiple elements starting from a specified position.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::erase(int pos, int count)
 {
     // Check if the position and count are within valid bounds
-    if (pos < 0 || pos >= m_size || count >= m_size || count < 0) {
+    if (pos < 0 || pos >= m_size || count >= m_size || count < 0 || pos + count > m_size) {
         throw std::out_of_range("Invalid position for erase");
     }
 
-    // If erasing at the beginning (position 0), use pop_front multiple times
-    if (pos == 0) {
-        for (int i = 0; i < count; ++i) {
-            pop_front();
-        }
-    } else if (pos == m_size - 1) { // If erasing at the end (position equal to current size - 1), use pop_back multiple times
-        for (int i = 0 ; i < count; ++i) {
-            pop_back();
-        }
-    } else { // Erase at a specific position within the list, multiple times
-        for (int i = 0; i < count; ++i) {
-            Node<T>* current = m_head;
-
-            // Traverse the list to find the node at the specified position
-            for (int i = 0; i < pos; ++i) {
-                current = current->m_next;
-            }
+    // Find the first node to remove once, the rest follow it on the insertion chain
+    node_type* current = node_at(pos);
 
-            // Update pointers to remove the current node
-            current->m_prev->m_next = current->m_next;
-            current->m_next->m_prev = current->m_prev;
+    for (int i = 0; i < count; ++i) {
+        node_type* next = current->m_next;
 
-            // Remove the current node from sorted order
-            remove_sorted_node(current);
+        // Remove the current node from both orders
+        unlink(current);
+        remove_sorted_node(current);
 
-            delete current;
-            --m_size;
-        }
+        destroy_node(current);
+        --m_size;
+        current = next;
     }
 }
 
 // Function removes the last element (tail) from the list.
-template <typename T>
-void SelfOrganizingSortedList<T>::pop_back() 
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::pop_back() 
 {
     // Check if the list is empty
     if (!m_tail) {
@@ -499,144 +1563,316 @@ void SelfOrganizingSortedList<T>::pop_back()
     }
 
     // Create a temporary pointer 'tmp' to the current tail node
-    Node<T>* tmp = m_tail;
-
-    // If there's only one element in the list, set all pointers to nullptr
-    if (m_head == m_tail) {
-        m_head = nullptr;
-        m_tail = nullptr;
-        m_asc_head = nullptr;
-        m_desc_head = nullptr;
-    } else {
-        // Update 'm_tail' to the previous node, and set its 'm_next' to nullptr
-        m_tail = m_tail->m_prev;
-        m_tail->m_next = nullptr;
-    }
+    node_type* tmp = m_tail;
 
-    // Remove the current tail node from sorted order
+    // Remove the current tail node from both orders
+    unlink(tmp);
     remove_sorted_node(tmp);
 
-    delete tmp;
+    destroy_node(tmp);
     --m_size;
 }
 
 // Function removes the first element (head) from the list.
-template <typename T>
-void SelfOrganizingSortedList<T>::pop_front()
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::pop_front()
 {
     if (!m_head) {
         throw std::runtime_error("List is empty. Cannot pop_front()");
     }
 
     // Create a temporary pointer 'tmp' to the current head node
-    Node<T>* tmp = m_head;
-
-    // If there's only one element in the list, set all pointers to nullptr
-    if (m_head == m_tail) {
-        m_head = nullptr;
-        m_tail = nullptr;
-        m_asc_head = nullptr;
-        m_desc_head = nullptr;
-    } else {
-        // Update 'm_head' to the next node, and set its 'm_prev' to nullptr
-        m_head = m_head->m_next;
-        m_head->m_prev = nullptr;
-    }
+    node_type* tmp = m_head;
 
-    // Remove the current head node from sorted order
+    // Remove the current head node from both orders
+    unlink(tmp);
     remove_sorted_node(tmp);
 
-    delete tmp;
+    destroy_node(tmp);
     --m_size;
 }
 
-// Function removes all occurrences of a specified element with the given data from the list.
-template <typename T>
-void SelfOrganizingSortedList<T>::remove(const T& data) 
+// Function removes all elements equal to the given data. The equal elements form a run of the sorted chain,
+// so only that run is visited after a single search.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::remove(const T& data) 
 {
     // Check if the list is empty
     if (!m_head) {
         throw std::runtime_error("List is empty. Cannot remove()");
     }
 
-    Node<T>* cur = m_head;
+    const key_type key = m_projection(data);
 
-    while (cur) {
-         // Check if the data of the current node matches the target data
-        if (cur->m_data == data) {
-            if (cur->m_prev) {
-                // Update the 'm_next' pointer of the previous node
-                cur->m_prev->m_next = cur->m_next;
-            } else {
-                // If there's no previous node, update the 'm_head' pointer
-                m_head = cur->m_next;
-            }
+    // Seek to the first equal element, then remove the run up to the first greater one
+    node_type* cur = lower_bound(key).get_node();
+    while (cur && !key_less(key, key_of(cur))) {
+        // Remember the next node of the run before 'cur' is released
+        node_type* next = cur->m_greater;
+        erase_node(cur);
+        cur = next;
+    }
+}
 
-             // Update the 'm_prev' pointer of the next node
-            if (cur->m_next) {
-                cur->m_next->m_prev = cur->m_prev;
-            } else {
-                // If there's no next node, update the 'm_tail' pointer
-                m_tail = cur->m_prev;
-            }
+// Function removes the first element with an equivalent key in sorted order, returns whether one was found.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::remove_one(const key_type& key)
+{
+    node_type* elem = find(key).get_node();
+    if (!elem) {
+        return false;
+    }
+
+    erase_node(elem);
+    return true;
+}
+
+// Function removes the first element with an equivalent key in sorted order and returns its value.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+T SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::extract(const key_type& key)
+{
+    node_type* elem = find(key).get_node();
+    if (!elem) {
+        throw std::runtime_error("No element with the given key. Cannot extract()");
+    }
 
-            // Remove the current node from the sorted order
-            remove_sorted_node(cur);
+    // Unlink the node first, so the list stays consistent if moving the value out throws
+    unlink(elem);
+    remove_sorted_node(elem);
+    --m_size;
 
-            delete cur;
-            --m_size;
-        }
-        // Move to the next node in the list
-        cur = cur->m_next;
+    try {
+        T result(std::move(elem->m_data));
+        destroy_node(elem);
+        return result;
+    } catch (...) {
+        destroy_node(elem);
+        throw;
     }
 }
 
-// Function removes all nodes from the sorted list for which a specified condition function returns true
-template <typename T>
-void SelfOrganizingSortedList<T>::remove_if(std::function<bool(const T&)> condition)
+// Function removes all elements for which the condition returns true. The condition is called once per element,
+// in insertion order, and the matching nodes are released together after a single pass.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename Predicate>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::remove_if(Predicate&& condition)
 {
     // Check if the list is empty
     if (!m_head) {
         throw std::runtime_error("List is empty. Cannot remove_if()");
     }
 
-    Node<T>* cur = m_head;
+    remove_nodes_if([&condition](const node_type* elem) {
+        return static_cast<bool>(condition(static_cast<const T&>(elem->m_data)));
+    });
+}
 
-    while (cur) {
-        // Check if the condition function returns true for the current node's data
-        if (condition(cur->m_data)) {
-            Node<T>* node_to_remove = cur;
+// Function removes all elements for which the condition returns true, evaluating the condition on 'threads' chunks
+// of the insertion order in parallel before the serial unlink pass. The condition must be safe to call concurrently,
+// the list is left unchanged if it throws.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename Predicate>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::remove_if(Predicate&& condition, int threads)
+{
+    // Check if the list is empty
+    if (!m_head) {
+        throw std::runtime_error("List is empty. Cannot remove_if()");
+    }
 
-            // Update the 'm_next' pointer of the previous node
-            if (cur->m_prev) {
-                cur->m_prev->m_next = cur->m_next;
-            } else {
-                // If there's no previous node, update the 'm_head' pointer
-                m_head = cur->m_next;
-            }
+    // Check if the number of threads is valid
+    if (threads < 1) {
+        throw std::runtime_error("threads must be positive");
+    }
+    if (threads > m_size) {
+        threads = m_size;
+    }
+    if (threads == 1) {
+        remove_if(condition);
+        return;
+    }
 
-            // Update the 'm_prev' pointer of the next node
-            if (cur->m_next) {
-                cur->m_next->m_prev = cur->m_prev;
-            } else {
-                // If there's no next node, update the 'm_tail' pointer
-                m_tail = cur->m_prev;
+    // One verdict per position, every chunk writes only its own part. Nothing is unlinked
+    // before all chunks are done, so a failure is reported as is.
+    std::vector<char> verdicts(m_size);
+
+    // The first node of every chunk is looked up here, so the chunks only read the nodes
+    std::vector<node_type*> starts(threads);
+    for (int chunk = 0; chunk < threads; ++chunk) {
+        starts[chunk] = node_at(static_cast<int>(static_cast<long long>(m_size) * chunk / threads));
+    }
+
+    run_chunks(threads, [&](int chunk) {
+        const int first = static_cast<int>(static_cast<long long>(m_size) * chunk / threads);
+        const int last = static_cast<int>(static_cast<long long>(m_size) * (chunk + 1) / threads);
+        node_type* cur = starts[chunk];
+        for (int pos = first; pos < last; ++pos, cur = cur->m_next) {
+            verdicts[pos] = condition(static_cast<const T&>(cur->m_data)) ? 1 : 0;
+        }
+    });
+
+    // The unlink pass walks the insertion order, so the verdicts are consumed by position
+    int pos = 0;
+    remove_nodes_if([&verdicts, &pos](const node_type*) {
+        return verdicts[pos++] != 0;
+    });
+}
+
+// Function runs task(chunk) for every chunk, the calling thread takes the first one. Once all chunks are done the
+// first failure, in chunk order, is rethrown.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename Function>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::run_chunks(int chunks, Function task)
+{
+    std::vector<std::exception_ptr> errors(chunks);
+    auto guarded = [&task, &errors](int chunk) {
+        try {
+            task(chunk);
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(chunks - 1);
+    try {
+        for (int chunk = 1; chunk < chunks; ++chunk) {
+            workers.emplace_back(guarded, chunk);
+        }
+    } catch (...) {
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        throw;
+    }
+    guarded(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/* Function sorts 'order' stably on 'threads' threads: every thread sorts one run, then neighbouring runs are
+   merged pairwise until one is left. Each merge is split into as many parts as there are threads for it, the
+   part boundaries are found by a binary search over both runs (the merge path). */
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename Less>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::parallel_sort(std::vector<int>& order, Less less, int threads)
+{
+    const int n = static_cast<int>(order.size());
+    std::vector<int> bounds(threads + 1);
+    for (int run = 0; run <= threads; ++run) {
+        bounds[run] = static_cast<int>(static_cast<long long>(n) * run / threads);
+    }
+
+    run_chunks(threads, [&](int run) {
+        std::stable_sort(order.begin() + bounds[run], order.begin() + bounds[run + 1], less);
+    });
+
+    std::vector<int> buffer(n);
+    for (int width = 1; width < threads; width *= 2) {
+        const int pairs = (threads + 2 * width - 1) / (2 * width);
+        const int parts = threads / pairs > 1 ? threads / pairs : 1;
+
+        run_chunks(pairs * parts, [&](int task) {
+            const int pair = task / parts;
+            const int part = task % parts;
+            const int* lhs = order.data() + bounds[std::min(2 * pair * width, threads)];
+            const int* rhs = order.data() + bounds[std::min((2 * pair + 1) * width, threads)];
+            const int lhs_size = static_cast<int>(rhs - lhs);
+            const int rhs_size = bounds[std::min((2 * pair + 2) * width, threads)] - bounds[std::min((2 * pair + 1) * width, threads)];
+            const int total = lhs_size + rhs_size;
+
+            // Number of elements taken from 'lhs' among the first 'k' merged ones, ties go to 'lhs'
+            auto split = [&](int k) {
+                int lo = k > rhs_size ? k - rhs_size : 0;
+                int hi = k < lhs_size ? k : lhs_size;
+                while (lo < hi) {
+                    const int i = lo + (hi - lo) / 2;
+                    if (!less(rhs[k - i - 1], lhs[i])) {
+                        lo = i + 1;
+                    } else {
+                        hi = i;
+                    }
+                }
+                return lo;
+            };
+
+            const int k_first = static_cast<int>(static_cast<long long>(total) * part / parts);
+            const int k_last = static_cast<int>(static_cast<long long>(total) * (part + 1) / parts);
+            const int i_first = split(k_first);
+            const int i_last = split(k_last);
+            std::merge(lhs + i_first, lhs + i_last, rhs + (k_first - i_first), rhs + (k_last - i_last),
+                buffer.begin() + (lhs - order.data()) + k_first, less);
+        });
+        order.swap(buffer);
+    }
+}
+
+// Function unlinks every node accepted by 'is_victim' from the base of both chains in one pass over the insertion
+// order, then relinks the express lanes of both orders once and releases the unlinked nodes.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename Function>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::remove_nodes_if(Function is_victim)
+{
+    node_type* victims = nullptr; // Unlinked nodes, chained through m_next
+    int removed = 0;
+    std::exception_ptr error;
+
+    try {
+        node_type* cur = m_head;
+        while (cur) {
+            // Remember the next node before 'cur' is unlinked
+            node_type* next = cur->m_next;
+
+            if (is_victim(cur)) {
+                // Join the neighbours in insertion order and in sorted order
+                next_link(cur->m_prev, 0) = cur->m_next;
+                prev_link(cur->m_next, 0) = cur->m_prev;
+                greater_link(cur->m_lesser, 0) = cur->m_greater;
+                lesser_link(cur->m_greater, 0) = cur->m_lesser;
+
+                if (cur == m_finger) {
+                    m_finger = nullptr;
+                }
+
+                cur->m_next = victims;
+                victims = cur;
+                ++removed;
             }
+            cur = next;
+        }
+    } catch (...) {
+        // Keep what has been unlinked so far, the list stays consistent
+        error = std::current_exception();
+    }
 
-            // Remove the current node from the sorted order
-            remove_sorted_node(node_to_remove);
+    if (removed > 0) {
+        m_size -= removed;
 
-            delete node_to_remove;
-            --m_size;
+        // The express lanes still pass through the victims, rebuild them over the remaining chains
+        link_sorted_lanes();
+        link_insertion_order();
+
+        while (victims) {
+            node_type* next = victims->m_next;
+            destroy_node(victims);
+            victims = next;
         }
-        // Move to the next node in the list
-        cur = cur->m_next;
-    }  
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
 }
 
 // Function allows elements from another SelfOrganizingSortedList (other) to be inserted into the current list at a specified position (pos).
-template <typename T>
-void SelfOrganizingSortedList<T>::splice(int pos, const SelfOrganizingSortedList<T>& other)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::splice(int pos, const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& other)
 {
     // Check if the specified position is negative
     if (pos < 0) {
@@ -648,25 +1884,28 @@ void SelfOrganizingSortedList<T>::splice(int pos, const SelfOrganizingSortedList
         throw std::runtime_error("List is empty");
     }
 
-    Node<T>* cur = other.m_head;
+    node_type* cur = other.m_head;
     // Iterate through the 'other' list and insert its elements into the current list at the specified position
     for (int i = 0; i < other.size(); ++i) {
-        insert(cur->m_data, pos + i);
+        // Rejected duplicates do not take a position
+        if (insert(cur->m_data, pos)) {
+            ++pos;
+        }
         cur = cur->m_next;
     }
 }
 
 // Function reverses the order of elements in the list.
-template <typename T>
-void SelfOrganizingSortedList<T>::reverse() 
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::reverse() 
 {
     // Check if the list is empty or contains only one element
     if (!m_head || !m_tail) {
         return;
     }
 
-    Node<T>* cur = m_head;
-    Node<T>* temp;
+    node_type* cur = m_head;
+    node_type* temp;
 
     while (cur) {
         // Swap next and prev
@@ -680,44 +1919,50 @@ void SelfOrganizingSortedList<T>::reverse()
     temp = m_head;
     m_head = m_tail;
     m_tail = temp;
+
+    // Positions have changed, relink the positional express lanes
+    link_insertion_order();
 }
 
 // Function removes a given node from the sorted order of the list. 
-template <typename T>
-void SelfOrganizingSortedList<T>::remove_sorted_node(Node<T>* elem)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::remove_sorted_node(node_type* elem)
 {
     // Check if the provided node 'elem' is valid
     if (!elem) {
         return;
     }
 
-    // Update the 'm_greater' pointer of the previous node to skip 'elem'
-    if (elem->m_lesser) {
-        elem->m_lesser->m_greater = elem->m_greater;
-    } else {
-        // If 'elem' was the first node in ascending order, update 'm_asc_head'
-        m_asc_head = elem->m_greater;
+    // Keep the finger on a node that stays in the list
+    if (elem == m_finger) {
+        m_finger = elem->m_lesser ? elem->m_lesser : elem->m_greater;
     }
 
-     // Update the 'm_lesser' pointer of the next node to skip 'elem'
-    if (elem->m_greater) {
-        elem->m_greater->m_lesser = elem->m_lesser;
-    } else {
-        // If 'elem' was the last node in descending order, update 'm_desc_head'
-        m_desc_head = elem->m_lesser;
+    // Unlink 'elem' from the sorted chain and from every express lane it takes part in.
+    // A null neighbour means 'elem' was the first (m_asc_head) or the last (m_desc_head) of that level.
+    for (int level = 0; level <= elem->m_level; ++level) {
+        node_type* lesser = lesser_link(elem, level);
+        node_type* greater = greater_link(elem, level);
+        greater_link(lesser, level) = greater;
+        lesser_link(greater, level) = lesser;
+    }
+
+    // Lower the search level while the highest express lane is empty
+    while (m_level > 0 && !m_lane_heads[m_level - 1].m_greater) {
+        --m_level;
     }
 }
 
 // Function prints the elements of the list in the order they appear in the list.
-template <typename T>
-void SelfOrganizingSortedList<T>::print_next()
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::print_next()
 {
     if (!m_head) {
         std::cout << "List is empty" << std::endl;
         return;
     }
 
-    Node<T>* cur = m_head;
+    node_type* cur = m_head;
 
     // Iterate through the list and print each element followed by a space
     while (cur) {
@@ -728,15 +1973,15 @@ void SelfOrganizingSortedList<T>::print_next()
 }
 
 // Function prints the elements of the list in reverse order.
-template <typename T>
-void SelfOrganizingSortedList<T>::print_prev()
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::print_prev()
 {
     if (!m_tail) {
         std::cout << "List is empty" << std::endl;
         return;
     }
 
-    Node<T>* cur = m_tail;
+    node_type* cur = m_tail;
 
     // Iterate through the list in reverse order and print each element followed by a space
     while (cur) {
@@ -747,15 +1992,15 @@ void SelfOrganizingSortedList<T>::print_prev()
 }
 
 // Function is designed to print the elements of the list in ascending order.
-template <typename T>
-void SelfOrganizingSortedList<T>::print_asc()
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::print_asc()
 {
     if (!m_asc_head) {
         std::cout << "List is empty" << std::endl;
         return;
     }
 
-    Node<T>* cur = m_asc_head;
+    node_type* cur = m_asc_head;
 
     // Iterate through the list in ascending order and print each element followed by a space
     while (cur) {
@@ -766,15 +2011,15 @@ void SelfOrganizingSortedList<T>::print_asc()
 }
 
 // Function is designed to print the elements of the list in descending order.
-template <typename T>
-void SelfOrganizingSortedList<T>::print_desc()
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::print_desc()
 {
     if (!m_desc_head) {
         std::cout << "List is empty" << std::endl;
         return;
     }
 
-    Node<T>* cur = m_desc_head;
+    node_type* cur = m_desc_head;
 
     // Iterate through the list in descending order and print each element followed by a space
     while (cur) {
@@ -785,57 +2030,263 @@ void SelfOrganizingSortedList<T>::print_desc()
 }
 
 // Return the current size of the list.
-template <typename T>
-int SelfOrganizingSortedList<T>::size() const
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+int SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::size() const
 {
     return m_size;
 }
 
-// Return a reference to the data of the first element (head) of the list.
-template <typename T>
-T& SelfOrganizingSortedList<T>::front()
+// Checks whether the list contains an element equal to the given value.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::contains(const key_type& key) const
 {
-    return m_head->m_data;
+    return find(key) != sorted_end();
+}
+
+// Function returns an iterator to the first element in sorted order equal to the given value, or sorted_end().
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::sorted_iterator SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::find(const key_type& key) const
+{
+    sorted_iterator it = lower_bound(key);
+
+    // The first element not less than the key is a match unless it is greater
+    if (it != sorted_end() && key_less(key, key_of(it.get_node()))) {
+        return sorted_end();
+    }
+    return it;
+}
+
+// Function returns the number of elements equal to the given value.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+int SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::count(const key_type& key) const
+{
+    int result = 0;
+
+    // Walk the run of equal elements, it ends at the first greater one
+    for (node_type* cur = lower_bound(key).get_node(); cur && !key_less(key, key_of(cur)); cur = cur->m_greater) {
+        ++result;
+    }
+    return result;
+}
+
+// Function returns an iterator to the first element in sorted order that is not less than the given value.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::sorted_iterator SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::lower_bound(const key_type& key) const
+{
+    SearchCost cost;
+    node_type* prev = find_sorted_predecessor(key, cost);
+    SOSL_STATS(m_stats.record_search(cost);)
+    return sorted_iterator(greater_link(prev, 0), &m_desc_head);
+}
+
+// Function returns an iterator to the first element in sorted order that is greater than the given value.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::sorted_iterator SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::upper_bound(const key_type& key) const
+{
+    SearchCost cost;
+    node_type* prev = find_sorted_last_not_greater(key, cost);
+    SOSL_STATS(m_stats.record_search(cost);)
+    return sorted_iterator(greater_link(prev, 0), &m_desc_head);
+}
+
+// Function returns the range of elements equal to the given value in sorted order.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+std::pair<typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::sorted_iterator, typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::sorted_iterator>
+SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::equal_range(const key_type& key) const
+{
+    sorted_iterator first = lower_bound(key);
+    sorted_iterator last = first;
+
+    // The run of equal elements is usually short, walk it instead of searching again
+    while (last != sorted_end() && !key_less(key, key_of(last.get_node()))) {
+        ++last;
+    }
+    return std::make_pair(first, last);
+}
+
+// Function calls 'fn' on every element in the key range [lo, hi), in ascending order.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+template <typename Function>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::for_each_in_range(const key_type& lo, const key_type& hi, Function fn) const
+{
+    // Seek to 'lo' once, then follow the sorted chain until 'hi'
+    for (node_type* cur = lower_bound(lo).get_node(); cur && key_less(key_of(cur), hi); cur = cur->m_greater) {
+        fn(static_cast<const T&>(cur->m_data));
+    }
+}
+
+// Function returns the number of elements in the key range [lo, hi).
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+int SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::count_range(const key_type& lo, const key_type& hi) const
+{
+    int result = 0;
+    for (node_type* cur = lower_bound(lo).get_node(); cur && key_less(key_of(cur), hi); cur = cur->m_greater) {
+        ++result;
+    }
+    return result;
+}
+
+// Function removes all elements in the key range [lo, hi) and returns how many were removed.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+int SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::erase_range(const key_type& lo, const key_type& hi)
+{
+    int result = 0;
+
+    // Seek to 'lo' once, the elements to remove form a contiguous run of the sorted chain
+    node_type* cur = lower_bound(lo).get_node();
+    while (cur && key_less(key_of(cur), hi)) {
+        node_type* next = cur->m_greater;
+        erase_node(cur);
+        ++result;
+        cur = next;
+    }
+    return result;
 }
 
 // Return a reference to the data of the first element (head) of the list (read-only).
-template <typename T>
-const T& SelfOrganizingSortedList<T>::front() const
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+const T& SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::front() const
 {
     return m_head->m_data;
 }
 
-// Return a reference to the data of the last element (tail) of the list.
-template <typename T>
-T& SelfOrganizingSortedList<T>::back()
+// Return a constant reference to the data of the last element (tail) of the list (read-only).
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+const T& SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::back() const
 {
     return m_tail->m_data;
 }
 
-// Return a constant reference to the data of the last element (tail) of the list (read-only).
-template <typename T>
-const T& SelfOrganizingSortedList<T>::back() const
+// Return a constant reference to the element at the given position, with bounds checking.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+const T& SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::at(int pos) const
 {
-    return m_tail->m_data;
+    if (pos < 0 || pos >= m_size) {
+        throw std::out_of_range("Invalid position for at");
+    }
+    return node_at(pos)->m_data;
+}
+
+// Return a constant reference to the element at the given position.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+const T& SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::operator[](int pos) const
+{
+    return node_at(pos)->m_data;
+}
+
+// Return an iterator to the first element in insertion order.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::const_iterator SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::begin() const
+{
+    return const_iterator(m_head, &m_tail);
+}
+
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::const_iterator SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::cbegin() const
+{
+    return begin();
+}
+
+// Return an iterator past the last element in insertion order.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::const_iterator SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::end() const
+{
+    return const_iterator(nullptr, &m_tail);
+}
+
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::const_iterator SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::cend() const
+{
+    return end();
+}
+
+// Return a reverse iterator to the last element in insertion order.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::const_reverse_iterator SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::rbegin() const
+{
+    return const_reverse_iterator(end());
+}
+
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::const_reverse_iterator SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::crbegin() const
+{
+    return rbegin();
+}
+
+// Return a reverse iterator before the first element in insertion order.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::const_reverse_iterator SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::rend() const
+{
+    return const_reverse_iterator(begin());
+}
+
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::const_reverse_iterator SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::crend() const
+{
+    return rend();
+}
+
+// Return an iterator to the smallest element.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::sorted_iterator SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::sorted_begin() const
+{
+    return sorted_iterator(m_asc_head, &m_desc_head);
+}
+
+// Return an iterator past the largest element.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::sorted_iterator SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::sorted_end() const
+{
+    return sorted_iterator(nullptr, &m_desc_head);
+}
+
+// Return a reverse iterator to the largest element.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::reverse_sorted_iterator SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::sorted_rbegin() const
+{
+    return reverse_sorted_iterator(sorted_end());
+}
+
+// Return a reverse iterator before the smallest element.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::reverse_sorted_iterator SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::sorted_rend() const
+{
+    return reverse_sorted_iterator(sorted_begin());
 }
 
 // Check if the list is empty by comparing the size to zero.
-template <typename T>
-bool SelfOrganizingSortedList<T>::empty() const
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::empty() const
 {
     return m_size == 0;
 }
 
 // Return a pointer to the head of the list.
-template <typename T>
-Node<T>* SelfOrganizingSortedList<T>::get_head() const
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type* SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::get_head() const
 {
     return m_head;
 }
 
+#ifdef SOSL_ENABLE_STATS
+// Return the counters of the work done since construction or the last reset_stats().
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+ListStats SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::stats() const
+{
+    return m_stats.snapshot();
+}
+
+// Function zeroes the counters.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::reset_stats()
+{
+    m_stats.reset();
+}
+#endif
+
 // Swaps the contents.
-template <typename T>
-void SelfOrganizingSortedList<T>::swap(SelfOrganizingSortedList<T>& other)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::swap(SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& other)
 {
     // Swap the size
     std::swap(m_size, other.m_size);
@@ -851,45 +2302,67 @@ void SelfOrganizingSortedList<T>::swap(SelfOrganizingSortedList<T>& other)
 
     // Swap the descending sorted head pointers
     std::swap(m_desc_head, other.m_desc_head);
+
+    // Swap the express lanes and the fingers
+    std::swap(m_lane_heads, other.m_lane_heads);
+    std::swap(m_level, other.m_level);
+    std::swap(m_finger, other.m_finger);
+
+    // Swap the node storage, each list takes over the allocations of the nodes it now owns
+    m_pool.swap(other.m_pool);
+    SOSL_STATS(m_stats.transfer_allocations(other.m_stats, static_cast<uint64_t>(m_size));)
+    SOSL_STATS(other.m_stats.transfer_allocations(m_stats, static_cast<uint64_t>(other.m_size));)
+
+    // Swap the ordering
+    std::swap(m_compare, other.m_compare);
+    std::swap(m_projection, other.m_projection);
 }
 
-// Removes duplicate elements.
-template <typename T>
-void SelfOrganizingSortedList<T>::unique()
+// Removes duplicate elements, keeping the first inserted element of every key. The duplicates are
+// released in one pass, the express lanes are relinked once.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::unique()
 {
     if (!m_asc_head) {
         // The list is empty, nothing to remove.
         return;
     }
 
-    Node<T>* cur = m_asc_head;
-
-    while (cur && cur->m_greater) {
-        if (cur->m_data == cur->m_greater->m_data) {
-            // Duplicate element found, remove the next (greater) node.
-            Node<T>* duplicate = cur->m_greater;
-            
-            duplicate->m_prev->m_next = duplicate->m_next;
-            duplicate->m_next->m_prev = duplicate->m_prev;
-
-            remove_sorted_node(duplicate);
-
-            --m_size; // Decrement the size.
-        } else {
-            // Move to the next element.
-            cur = cur->m_greater;
-        }
-    }
+    // Equal elements are adjacent in sorted order and the first inserted one is the last of them,
+    // every other one is followed by an equal element
+    remove_nodes_if([this](const node_type* elem) {
+        return elem->m_greater && !key_less(key_of(elem), key_of(elem->m_greater));
+    });
 }
 
 // Function allows to combine the contents of two lists.
-template <typename T>
-void SelfOrganizingSortedList<T>::merge(SelfOrganizingSortedList<T>& other)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::merge(SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& other)
 {
-    if (!other.m_head) {
+    if (this == &other || !other.m_head) {
         return; // Nothing to merge from the other list.
     }
 
+    // With unique keys, the elements of 'other' whose key is already present are dropped
+    if constexpr (UniqueKeys) {
+        node_type* mine = m_asc_head;
+        node_type* theirs = other.m_asc_head;
+        while (mine && theirs) {
+            if (key_less(key_of(mine), key_of(theirs))) {
+                mine = mine->m_greater;
+            } else if (key_less(key_of(theirs), key_of(mine))) {
+                theirs = theirs->m_greater;
+            } else {
+                node_type* next = theirs->m_greater;
+                other.erase_node(theirs);
+                theirs = next;
+            }
+        }
+        if (!other.m_head) {
+            return;
+        }
+    }
+
     if (!m_head) {
         // If the current list is empty, simply copy the other list.
         m_head = other.m_head;
@@ -897,6 +2370,11 @@ void SelfOrganizingSortedList<T>::merge(SelfOrganizingSortedList<T>& other)
         m_asc_head = other.m_asc_head;
         m_desc_head = other.m_desc_head;
         m_size = other.m_size;
+        std::swap(m_lane_heads, other.m_lane_heads);
+        std::swap(m_level, other.m_level);
+        std::swap(m_finger, other.m_finger);
+        m_pool.swap(other.m_pool);
+        SOSL_STATS(m_stats.transfer_allocations(other.m_stats, static_cast<uint64_t>(m_size));)
 
         // Clear the other list.
         other.m_head = nullptr;
@@ -904,57 +2382,114 @@ void SelfOrganizingSortedList<T>::merge(SelfOrganizingSortedList<T>& other)
         other.m_asc_head = nullptr;
         other.m_desc_head = nullptr;
         other.m_size = 0;
+        other.reset_lanes();
 
         return;
     }
 
-    // Merge the two lists into the current list.
-    while (other.m_head) {
-        Node<T>* cur = other.m_head;
-        other.m_head = other.m_head->m_next;
-        cur->m_next = nullptr;
-        cur->m_prev = nullptr;
-        cur->m_lesser = nullptr;
-        cur->m_greater = nullptr;
+    // The nodes of the other list now belong to this one
+    m_pool.adopt(other.m_pool);
+    SOSL_STATS(m_stats.transfer_allocations(other.m_stats, static_cast<uint64_t>(other.m_size));)
+
+    // Concatenate the insertion orders, the positional lanes only need stitching at the seam
+    append_insertion_order(other);
 
-        m_tail->m_next = cur;
-        cur->m_prev = m_tail;
-        m_tail = cur;
-        put_in_sorted_order(m_tail); // Ensure sorted order is maintained.
+    // Merge the sorted chains with two fingers. On ties the node of 'other' goes first,
+    // as if its elements had been pushed after ours.
+    node_type* mine = m_asc_head;
+    node_type* theirs = other.m_asc_head;
+    node_type* last = nullptr;
+    while (mine || theirs) {
+        node_type* next = nullptr;
+        if (!theirs || (mine && key_less(key_of(mine), key_of(theirs)))) {
+            next = mine;
+            mine = mine->m_greater;
+        } else {
+            next = theirs;
+            theirs = theirs->m_greater;
+        }
+        next->m_lesser = last;
+        greater_link(last, 0) = next;
+        last = next;
     }
+    last->m_greater = nullptr;
+    m_desc_head = last;
+
+    // Relink the sorted express lanes over the merged chain
+    link_sorted_lanes();
+
+    m_size += other.m_size;
 
     // Clear the other list.
+    other.m_head = nullptr;
     other.m_tail = nullptr;
     other.m_asc_head = nullptr;
     other.m_desc_head = nullptr;
     other.m_size = 0;
+    other.reset_lanes();
+}
+
+// Function appends the insertion order of another list behind ours, stitching the positional
+// express lanes at the seam in O(log n) expected.
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::append_insertion_order(SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& other)
+{
+    // Walk back from our tail to the last node on every level, counting how far it is from
+    // the first node of 'other' (position m_size once appended)
+    const int top = other.m_level > m_level ? other.m_level : m_level;
+    node_type* before = m_tail;
+    int distance = 1;
+    for (int level = 1; level <= top; ++level) {
+        while (before && before->m_level < level) {
+            node_type* lower = prev_link(before, level - 1);
+            distance += level == 1 ? 1 : span_link(lower, level - 1);
+            before = lower;
+        }
+
+        // The first node of 'other' on this level sits at position (span - 1) of 'other'
+        node_type* first = other.next_link(nullptr, level);
+        if (first) {
+            next_link(before, level) = first;
+            prev_link(first, level) = before;
+            span_link(before, level) = distance + other.span_link(nullptr, level) - 1;
+            prev_link(nullptr, level) = other.prev_link(nullptr, level);
+        }
+    }
+
+    // Join the insertion chains
+    next_link(m_tail, 0) = other.m_head;
+    other.m_head->m_prev = m_tail;
+    m_tail = other.m_tail;
 }
 
 // Sorts the elements in the SelfOrganizingSortedList in ascending order.
-template <typename T>
-void SelfOrganizingSortedList<T>::sort()
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::sort()
 {
     // Reconfigure pointers for ascending order.
     m_head = m_asc_head;
     m_tail = m_desc_head;
-    Node<T>* cur = m_head;
+    node_type* cur = m_head;
     while (cur) {
         cur->m_next = cur->m_greater;
         cur->m_prev = cur->m_lesser;
         cur = cur->m_next;
     }
+
+    // Positions have changed, relink the positional express lanes
+    link_insertion_order();
 }
 
 // Checks that lhs == rhs
-template <typename T>
-bool operator==(const SelfOrganizingSortedList<T>& lhs, const SelfOrganizingSortedList<T>& rhs)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool operator==(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& lhs, const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& rhs)
 {
     if (lhs.size() != rhs.size()) {
         return false;
     }
 
-    Node<T>* cur1 = lhs.get_head();
-    Node<T>* cur2 = rhs.get_head();
+    const typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type* cur1 = lhs.get_head();
+    const typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type* cur2 = rhs.get_head();
 
     // Compare the elements of both lists element by element
     while (cur1) {
@@ -968,23 +2503,23 @@ bool operator==(const SelfOrganizingSortedList<T>& lhs, const SelfOrganizingSort
 }
 
 // Checks that lhs != rhs
-template <typename T>
-bool operator!=(const SelfOrganizingSortedList<T>& lhs, const SelfOrganizingSortedList<T>& rhs)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool operator!=(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& lhs, const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& rhs)
 {
     // Invert the result of the equality operator to check if the lists are not equal
     return !(lhs == rhs);
 }
 
 // Checks that lhs < rhs
-template <typename T>
-bool operator<(const SelfOrganizingSortedList<T>& lhs, const SelfOrganizingSortedList<T>& rhs)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool operator<(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& lhs, const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& rhs)
 {
     if (lhs.size() != rhs.size()) {
         return false;
     }
 
-    Node<T>* cur1 = lhs.get_head();
-    Node<T>* cur2 = rhs.get_head();
+    const typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type* cur1 = lhs.get_head();
+    const typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type* cur2 = rhs.get_head();
 
     // Compare the elements of both lists element by element
     while (cur1) {
@@ -998,15 +2533,15 @@ bool operator<(const SelfOrganizingSortedList<T>& lhs, const SelfOrganizingSorte
 }
 
 // Checks that lhs <= rhs
-template <typename T>
-bool operator<=(const SelfOrganizingSortedList<T>& lhs, const SelfOrganizingSortedList<T>& rhs)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool operator<=(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& lhs, const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& rhs)
 {
     if (lhs.size() != rhs.size()) {
         return false;
     }
 
-    Node<T>* cur1 = lhs.get_head();
-    Node<T>* cur2 = rhs.get_head();
+    const typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type* cur1 = lhs.get_head();
+    const typename SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>::node_type* cur2 = rhs.get_head();
 
     // Compare the elements of both lists element by element
     while (cur1) {
@@ -1020,16 +2555,16 @@ bool operator<=(const SelfOrganizingSortedList<T>& lhs, const SelfOrganizingSort
 }
 
 // Checks that lhs > rhs
-template <typename T>
-bool operator>(const SelfOrganizingSortedList<T>& lhs, const SelfOrganizingSortedList<T>& rhs)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool operator>(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& lhs, const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& rhs)
 {
     // Use the < operator to check if 'lhs' is greater than 'rhs', then invert the result
     return !(lhs < rhs);
 }
 
 // Checks that lhs >= rhs
-template <typename T>
-bool operator>=(const SelfOrganizingSortedList<T>& lhs, const SelfOrganizingSortedList<T>& rhs)
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+bool operator>=(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& lhs, const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& rhs)
 {
     // Use the <= operator to check if 'lhs' is greater than or equal to 'rhs', then invert the result
     return !(lhs <= rhs);
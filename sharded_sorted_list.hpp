@@ -0,0 +1,99 @@
+#ifndef SHARDED_SORTED_LIST_HPP_
+#define SHARDED_SORTED_LIST_HPP_
+
+#include "self_organizing_sorted_list.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/* Sorted list split by key ranges into shards, so that threads inserting different keys do not
+   wait for each other. Shard i holds the keys in [splitters[i - 1], splitters[i]), every shard is a
+   SelfOrganizingSortedList with its own node pool behind its own mutex.
+   Every element is stamped with a global sequence number while its shard is locked, so the insertion
+   order is rebuilt by merging the shards on it. The sorted order is the shards one after another. */
+template <typename T, typename Compare = std::less<>>
+class ShardedSortedList
+{
+public:
+    using value_type = T;
+    using key_compare = Compare;
+
+    // Element of a shard, stamped with its position in the global insertion order
+    struct Entry
+    {
+        uint64_t m_sequence;
+        T m_value;
+    };
+
+    // Orders the entries by their values
+    struct EntryCompare
+    {
+        bool operator()(const Entry& lhs, const Entry& rhs) const
+        {
+            return m_compare(lhs.m_value, rhs.m_value);
+        }
+
+        Compare m_compare;
+    };
+
+    using shard_type = SelfOrganizingSortedList<Entry, EntryCompare>;
+
+public:
+    ShardedSortedList(); // Default constructor, a single shard
+    explicit ShardedSortedList(std::vector<T> splitters, const Compare& compare = Compare()); // One more shard than splitters
+
+    ShardedSortedList(const ShardedSortedList<T, Compare>& other) = delete;
+    ShardedSortedList<T, Compare>& operator=(const ShardedSortedList<T, Compare>& other) = delete;
+
+    static std::vector<T> make_splitters(std::vector<T> sample, int shards, const Compare& compare = Compare()); // Splitters cutting a sample into equal parts
+
+public:
+    // Modifiers, safe to call from several threads
+    void push_back(const T& value); // Adds an element to the end of the insertion order
+    void remove(const T& value); // Removes all equal elements
+    bool remove_one(const T& value); // Removes the first equal element in sorted order
+    void clear(); // Clears the contents
+
+    // Lookup
+    bool contains(const T& value) const; // Checks whether an equal element exists
+    int count(const T& value) const; // Returns the number of equal elements
+
+    // Traversals
+    template <typename Function>
+    void for_each(Function&& function) const; // Calls function on every element in insertion order
+    template <typename Function>
+    void for_each_sorted(Function&& function) const; // Calls function on every element in ascending order
+    template <typename Function>
+    void for_each_in_range(const T& low, const T& high, Function&& function) const; // Ascending elements in [low, high)
+
+    // Capacity
+    bool empty() const; // Checks whether the container is empty
+    int size() const; // Returns the number of elements
+    int shard_count() const; // Returns the number of shards
+
+private:
+    // One cache line apart, so that the locks of neighbouring shards do not share a line
+    struct alignas(64) Shard
+    {
+        explicit Shard(const EntryCompare& compare);
+
+        mutable std::mutex m_mutex;
+        shard_type m_list;
+    };
+
+    int shard_of(const T& value) const; // Index of the shard holding the value's key range
+    Entry probe(const T& value) const; // Entry used to look a value up
+
+private:
+    std::vector<T> m_splitters; // First key of every shard but the first
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    std::atomic<uint64_t> m_sequence; // Next insertion sequence number
+    Compare m_compare; // Orders the elements
+};
+
+#include "sharded_sorted_list_impl_.hpp"
+
+#endif // SHARDED_SORTED_LIST_HPP_
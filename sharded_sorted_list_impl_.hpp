@@ -0,0 +1,228 @@
+#ifndef SHARDED_SORTED_LIST_IMPL_HPP_
+#define SHARDED_SORTED_LIST_IMPL_HPP_
+
+#include <algorithm>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+// Constructor of a shard
+template <typename T, typename Compare>
+ShardedSortedList<T, Compare>::Shard::Shard(const EntryCompare& compare)
+    : m_mutex()
+    , m_list(compare)
+{
+}
+
+// Default constructor
+template <typename T, typename Compare>
+ShardedSortedList<T, Compare>::ShardedSortedList()
+    : ShardedSortedList(std::vector<T>())
+{
+}
+
+// Constructor with the splitters between the shards and a comparator
+template <typename T, typename Compare>
+ShardedSortedList<T, Compare>::ShardedSortedList(std::vector<T> splitters, const Compare& compare)
+    : m_splitters(std::move(splitters))
+    , m_shards()
+    , m_sequence(0)
+    , m_compare(compare)
+{
+    // The key ranges must follow each other
+    for (size_t i = 1; i < m_splitters.size(); ++i) {
+        if (m_compare(m_splitters[i], m_splitters[i - 1])) {
+            throw std::runtime_error("Splitters are not sorted");
+        }
+    }
+
+    m_shards.reserve(m_splitters.size() + 1);
+    for (size_t i = 0; i <= m_splitters.size(); ++i) {
+        m_shards.push_back(std::unique_ptr<Shard>(new Shard(EntryCompare{m_compare})));
+    }
+}
+
+// Function picks the splitters dividing a sample of the keys into 'shards' parts of equal size.
+template <typename T, typename Compare>
+std::vector<T> ShardedSortedList<T, Compare>::make_splitters(std::vector<T> sample, int shards, const Compare& compare)
+{
+    std::vector<T> splitters;
+    if (sample.empty() || shards < 2) {
+        return splitters;
+    }
+
+    std::sort(sample.begin(), sample.end(), compare);
+    splitters.reserve(shards - 1);
+    for (int i = 1; i < shards; ++i) {
+        splitters.push_back(sample[sample.size() * i / shards]);
+    }
+    return splitters;
+}
+
+/* Function adds a value to the shard of its key range. The sequence number is taken under the
+   shard's lock, so the insertion chain of every shard stays ordered by it. */
+template <typename T, typename Compare>
+void ShardedSortedList<T, Compare>::push_back(const T& value)
+{
+    Shard& shard = *m_shards[shard_of(value)];
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    shard.m_list.push_back(Entry{m_sequence.fetch_add(1, std::memory_order_relaxed), value});
+}
+
+// Function removes all elements equal to the value.
+template <typename T, typename Compare>
+void ShardedSortedList<T, Compare>::remove(const T& value)
+{
+    Shard& shard = *m_shards[shard_of(value)];
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    if (!shard.m_list.empty()) {
+        shard.m_list.remove(probe(value));
+    }
+}
+
+// Function removes the first element equal to the value in sorted order, returns whether one was found.
+template <typename T, typename Compare>
+bool ShardedSortedList<T, Compare>::remove_one(const T& value)
+{
+    Shard& shard = *m_shards[shard_of(value)];
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    return shard.m_list.remove_one(probe(value));
+}
+
+// Function clears the shards one after another.
+template <typename T, typename Compare>
+void ShardedSortedList<T, Compare>::clear()
+{
+    for (const std::unique_ptr<Shard>& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard->m_mutex);
+        shard->m_list.clear();
+    }
+}
+
+// Function checks whether an element equal to the value exists.
+template <typename T, typename Compare>
+bool ShardedSortedList<T, Compare>::contains(const T& value) const
+{
+    const Shard& shard = *m_shards[shard_of(value)];
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    return shard.m_list.contains(probe(value));
+}
+
+// Function returns the number of elements equal to the value.
+template <typename T, typename Compare>
+int ShardedSortedList<T, Compare>::count(const T& value) const
+{
+    const Shard& shard = *m_shards[shard_of(value)];
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    return shard.m_list.count(probe(value));
+}
+
+/* Function calls 'function' on every element in insertion order. All shards are locked, in index order
+   to stay clear of deadlocks, and their insertion chains are merged on the sequence numbers. */
+template <typename T, typename Compare>
+template <typename Function>
+void ShardedSortedList<T, Compare>::for_each(Function&& function) const
+{
+    using cursor = typename shard_type::const_iterator;
+
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(m_shards.size());
+    for (const std::unique_ptr<Shard>& shard : m_shards) {
+        locks.emplace_back(shard->m_mutex);
+    }
+
+    // Heap of the next sequence number of every shard that is not exhausted
+    std::vector<cursor> cursors;
+    cursors.reserve(m_shards.size());
+    std::priority_queue<std::pair<uint64_t, size_t>, std::vector<std::pair<uint64_t, size_t>>, std::greater<std::pair<uint64_t, size_t>>> heads;
+    for (size_t i = 0; i < m_shards.size(); ++i) {
+        const shard_type& list = m_shards[i]->m_list;
+        cursors.push_back(list.cbegin());
+        if (cursors[i] != list.cend()) {
+            heads.emplace(cursors[i]->m_sequence, i);
+        }
+    }
+
+    while (!heads.empty()) {
+        const size_t i = heads.top().second;
+        heads.pop();
+
+        function(cursors[i]->m_value);
+        if (++cursors[i] != m_shards[i]->m_list.cend()) {
+            heads.emplace(cursors[i]->m_sequence, i);
+        }
+    }
+}
+
+// Function calls 'function' on every element in ascending order, visiting the shards one after another.
+template <typename T, typename Compare>
+template <typename Function>
+void ShardedSortedList<T, Compare>::for_each_sorted(Function&& function) const
+{
+    for (const std::unique_ptr<Shard>& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard->m_mutex);
+        for (auto it = shard->m_list.sorted_begin(); it != shard->m_list.sorted_end(); ++it) {
+            function(it->m_value);
+        }
+    }
+}
+
+// Function calls 'function' in ascending order on every element not less than 'low' and less than 'high'.
+template <typename T, typename Compare>
+template <typename Function>
+void ShardedSortedList<T, Compare>::for_each_in_range(const T& low, const T& high, Function&& function) const
+{
+    if (!m_compare(low, high)) {
+        return;
+    }
+
+    // Only the shards whose key ranges overlap [low, high) are visited
+    const int last = shard_of(high);
+    for (int i = shard_of(low); i <= last; ++i) {
+        const Shard& shard = *m_shards[i];
+        std::lock_guard<std::mutex> lock(shard.m_mutex);
+        shard.m_list.for_each_in_range(probe(low), probe(high), [&function](const Entry& entry) { function(entry.m_value); });
+    }
+}
+
+// Checks if the list is empty.
+template <typename T, typename Compare>
+bool ShardedSortedList<T, Compare>::empty() const
+{
+    return size() == 0;
+}
+
+// Return the number of elements, summed over the shards one after another.
+template <typename T, typename Compare>
+int ShardedSortedList<T, Compare>::size() const
+{
+    int result = 0;
+    for (const std::unique_ptr<Shard>& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard->m_mutex);
+        result += shard->m_list.size();
+    }
+    return result;
+}
+
+// Return the number of shards.
+template <typename T, typename Compare>
+int ShardedSortedList<T, Compare>::shard_count() const
+{
+    return static_cast<int>(m_shards.size());
+}
+
+// Function returns the index of the shard whose key range holds the value.
+template <typename T, typename Compare>
+int ShardedSortedList<T, Compare>::shard_of(const T& value) const
+{
+    return static_cast<int>(std::upper_bound(m_splitters.begin(), m_splitters.end(), value, m_compare) - m_splitters.begin());
+}
+
+// Function returns an entry holding the value, for lookups in a shard.
+template <typename T, typename Compare>
+typename ShardedSortedList<T, Compare>::Entry ShardedSortedList<T, Compare>::probe(const T& value) const
+{
+    return Entry{0, value};
+}
+
+#endif // SHARDED_SORTED_LIST_IMPL_HPP_
@@ -0,0 +1,124 @@
+#ifndef SNAPSHOT_HPP_
+#define SNAPSHOT_HPP_
+
+#include "projection.hpp"
+#include "self_organizing_sorted_list.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/* Binary snapshot of a sorted list, written by save_snapshot():
+     SnapshotHeader                          32 bytes
+     values in insertion order               m_count * m_value_size bytes, raw copies of T
+     padding to a multiple of 4 bytes
+     sorted order                            m_count uint32_t, the insertion index of every element in ascending order
+   All numbers are in the byte order of the machine that wrote the file, a file from a machine with the
+   other byte order is recognized by its magic and rejected. */
+constexpr uint32_t kSnapshotMagic = 0x4C534F53u; // "SOSL" read as a little endian number
+constexpr uint32_t kSnapshotVersion = 1;
+constexpr uint32_t kSnapshotUniqueKeys = 1u; // Flag: written by a list with unique keys
+
+struct SnapshotHeader
+{
+    uint32_t m_magic;
+    uint32_t m_version;
+    uint32_t m_value_size; // sizeof(T) of the writer
+    uint32_t m_flags;
+    uint64_t m_count; // Number of elements
+    uint64_t m_order_offset; // Byte offset of the sorted order
+};
+
+// Read-only contents of a file, memory-mapped where the platform allows it and read into memory otherwise
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& path); // Maps the whole file, throws std::runtime_error on failure
+    ~MappedFile(); // Unmaps the file
+
+    MappedFile(const MappedFile& other) = delete;
+    MappedFile& operator=(const MappedFile& other) = delete;
+
+    MappedFile(MappedFile&& other) noexcept; // Move constructor
+    MappedFile& operator=(MappedFile&& other) noexcept; // Move assignment operator
+
+public:
+    const char* data() const; // First byte of the file
+    size_t size() const; // Size of the file in bytes
+
+private:
+    void unmap(); // Releases the mapping
+
+private:
+    const char* m_data;
+    size_t m_size;
+    bool m_mapped; // Whether m_data is a mapping or points into m_buffer
+    std::vector<std::max_align_t> m_buffer; // Contents read into memory where mapping is not available
+};
+
+// Function checks the header and the size of a snapshot of T, returns the header
+template <typename T>
+const SnapshotHeader& check_snapshot(const char* data, size_t size);
+
+// Function writes a snapshot of values given in insertion order and their sorted order
+template <typename T>
+void write_snapshot(const std::string& path, const std::vector<const T*>& values, const std::vector<uint32_t>& order, uint32_t flags);
+
+// Function writes both orders of a list to a snapshot file, T has to be trivially copyable
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void save_snapshot(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& list, const std::string& path);
+
+// Function replaces the contents of a list with a snapshot file, linking both orders without comparisons
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void load_snapshot(SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& list, const std::string& path);
+
+/* Read-only view of a snapshot file, without copying or linking anything: the values are read in place
+   from the mapped file. Lookups binary search the stored sorted order, so they need the Compare and
+   the Projection the snapshot was written with. */
+template <typename T, typename Compare = std::less<>, typename Projection = IdentityProjection>
+class SnapshotView
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SnapshotView requires a trivially copyable T");
+    static_assert(alignof(T) <= alignof(std::max_align_t), "SnapshotView requires T to need no more than the fundamental alignment");
+
+public:
+    using value_type = T;
+    using key_type = typename std::decay<decltype(std::declval<const Projection&>()(std::declval<const T&>()))>::type;
+    using const_iterator = const T*; // Insertion order
+
+    explicit SnapshotView(const std::string& path, const Compare& compare = Compare(), const Projection& projection = Projection()); // Maps and checks a snapshot file
+
+public:
+    // Element access
+    const T& operator[](int pos) const; // Element at a position of the insertion order
+    const T& sorted_at(int rank) const; // Element at a rank of the sorted order
+
+    // Lookup
+    bool contains(const key_type& key) const; // Checks whether an element with an equal key exists
+    int count(const key_type& key) const; // Returns the number of elements with an equal key
+    int lower_bound(const key_type& key) const; // Rank of the first element whose key is not less than key
+    int upper_bound(const key_type& key) const; // Rank of the first element whose key is greater than key
+
+    // Iterators
+    const_iterator begin() const; // Insertion order
+    const_iterator end() const;
+
+    // Capacity
+    bool empty() const; // Checks whether the snapshot is empty
+    int size() const; // Returns the number of elements
+
+private:
+    MappedFile m_file;
+    const T* m_values; // Values in insertion order, inside the mapping
+    const uint32_t* m_order; // Sorted order, inside the mapping
+    int m_size;
+    Compare m_compare; // Orders the keys
+    Projection m_projection; // Maps an element to its key
+};
+
+#include "snapshot_impl_.hpp"
+
+#endif // SNAPSHOT_HPP_
@@ -0,0 +1,359 @@
+#ifndef SNAPSHOT_IMPL_HPP_
+#define SNAPSHOT_IMPL_HPP_
+
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+// Only used by the MappedFile functions below, undefined again at the end of the file
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SNAPSHOT_HAS_MMAP_ 1
+#endif
+
+// Constructor mapping a file
+inline MappedFile::MappedFile(const std::string& path)
+    : m_data(nullptr)
+    , m_size(0)
+    , m_mapped(false)
+    , m_buffer()
+{
+#ifdef SNAPSHOT_HAS_MMAP_
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot read the size of " + path);
+    }
+    m_size = static_cast<size_t>(info.st_size);
+
+    // An empty file cannot be mapped, it has no contents to show either
+    if (m_size > 0) {
+        void* mapping = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Cannot map " + path);
+        }
+        m_data = static_cast<const char*>(mapping);
+        m_mapped = true;
+    }
+
+    // The mapping stays valid without the descriptor
+    ::close(fd);
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    m_size = static_cast<size_t>(in.tellg());
+    m_buffer.resize((m_size + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t));
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(m_size))) {
+        throw std::runtime_error("Cannot read " + path);
+    }
+    m_data = reinterpret_cast<const char*>(m_buffer.data());
+#endif
+}
+
+// Destructor
+inline MappedFile::~MappedFile()
+{
+    unmap();
+}
+
+// Move constructor
+inline MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(other.m_data)
+    , m_size(other.m_size)
+    , m_mapped(other.m_mapped)
+    , m_buffer(std::move(other.m_buffer))
+{
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_mapped = false;
+}
+
+// Move assignment operator
+inline MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        unmap();
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_mapped = other.m_mapped;
+        m_buffer = std::move(other.m_buffer);
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_mapped = false;
+    }
+    return *this;
+}
+
+// Return the first byte of the file.
+inline const char* MappedFile::data() const
+{
+    return m_data;
+}
+
+// Return the size of the file in bytes.
+inline size_t MappedFile::size() const
+{
+    return m_size;
+}
+
+// Function releases the mapping, the buffer is released with the object.
+inline void MappedFile::unmap()
+{
+#ifdef SNAPSHOT_HAS_MMAP_
+    if (m_mapped) {
+        ::munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+}
+
+// Function checks that a snapshot was written for T by this format version and that the file holds all its parts.
+template <typename T>
+const SnapshotHeader& check_snapshot(const char* data, size_t size)
+{
+    if (size < sizeof(SnapshotHeader)) {
+        throw std::runtime_error("Snapshot is truncated");
+    }
+    const SnapshotHeader& header = *reinterpret_cast<const SnapshotHeader*>(data);
+
+    if (header.m_magic != kSnapshotMagic) {
+        throw std::runtime_error("Not a snapshot, or written with a different byte order");
+    }
+    if (header.m_version != kSnapshotVersion) {
+        throw std::runtime_error("Unsupported snapshot version");
+    }
+    if (header.m_value_size != sizeof(T)) {
+        throw std::runtime_error("Snapshot was written for a different element type");
+    }
+    if (header.m_count > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+        throw std::runtime_error("Snapshot holds too many elements");
+    }
+
+    // The values are followed by the sorted order, which starts at the next multiple of 4
+    const uint64_t values_end = sizeof(SnapshotHeader) + header.m_count * sizeof(T);
+    const uint64_t order_offset = (values_end + 3) / 4 * 4;
+    if (header.m_order_offset != order_offset || order_offset + header.m_count * sizeof(uint32_t) > size) {
+        throw std::runtime_error("Snapshot is truncated");
+    }
+    return header;
+}
+
+// Function writes the header, the values in insertion order and the sorted order to a new file.
+template <typename T>
+void write_snapshot(const std::string& path, const std::vector<const T*>& values, const std::vector<uint32_t>& order, uint32_t flags)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot create " + path);
+    }
+
+    SnapshotHeader header;
+    header.m_magic = kSnapshotMagic;
+    header.m_version = kSnapshotVersion;
+    header.m_value_size = sizeof(T);
+    header.m_flags = flags;
+    header.m_count = values.size();
+    header.m_order_offset = (sizeof(SnapshotHeader) + values.size() * sizeof(T) + 3) / 4 * 4;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const T* value : values) {
+        out.write(reinterpret_cast<const char*>(value), sizeof(T));
+    }
+
+    // Pad the values to the start of the sorted order
+    const char padding[4] = {};
+    out.write(padding, static_cast<std::streamsize>(header.m_order_offset - sizeof(SnapshotHeader) - values.size() * sizeof(T)));
+    out.write(reinterpret_cast<const char*>(order.data()), static_cast<std::streamsize>(order.size() * sizeof(uint32_t)));
+
+    if (!out.flush()) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+}
+
+/* Function writes the values of a list in insertion order and, as insertion indices, its sorted order to a snapshot
+   file. The values are copied byte by byte, so T has to be trivially copyable. */
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void save_snapshot(const SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& list, const std::string& path)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "save_snapshot() requires a trivially copyable T");
+
+    // Remember the insertion index of every element, elements are told apart by their address
+    NodeMap<T, uint32_t> indices(list.size());
+    std::vector<const T*> values;
+    values.reserve(list.size());
+    for (const T& value : list) {
+        indices.insert(&value, static_cast<uint32_t>(values.size()));
+        values.push_back(&value);
+    }
+
+    std::vector<uint32_t> order;
+    order.reserve(list.size());
+    for (auto it = list.sorted_begin(); it != list.sorted_end(); ++it) {
+        order.push_back(indices.at(&*it));
+    }
+
+    write_snapshot<T>(path, values, order, UniqueKeys ? kSnapshotUniqueKeys : 0u);
+}
+
+/* Function replaces the contents of a list with a snapshot file. The file is memory-mapped and the list links both
+   orders straight from it, so no key is compared. The snapshot must have been written by a list with the same
+   ordering. */
+template <typename T, typename Compare, typename Projection, bool UniqueKeys>
+void load_snapshot(SelfOrganizingSortedList<T, Compare, Projection, UniqueKeys>& list, const std::string& path)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "load_snapshot() requires a trivially copyable T");
+
+    const MappedFile file(path);
+    const SnapshotHeader& header = check_snapshot<T>(file.data(), file.size());
+    if (UniqueKeys && !(header.m_flags & kSnapshotUniqueKeys)) {
+        throw std::runtime_error("Snapshot may hold repeated keys. Cannot load_snapshot()");
+    }
+
+    const int count = static_cast<int>(header.m_count);
+    const T* values = reinterpret_cast<const T*>(file.data() + sizeof(SnapshotHeader));
+    const uint32_t* order = reinterpret_cast<const uint32_t*>(file.data() + header.m_order_offset);
+
+    // The sorted order must name every element exactly once
+    std::vector<char> seen(count, 0);
+    for (int rank = 0; rank < count; ++rank) {
+        if (order[rank] >= static_cast<uint32_t>(count) || seen[order[rank]]) {
+            throw std::runtime_error("Snapshot has a corrupt sorted order. Cannot load_snapshot()");
+        }
+        seen[order[rank]] = 1;
+    }
+
+    list.assign_orders(values, order, count);
+}
+
+// Constructor mapping a snapshot file
+template <typename T, typename Compare, typename Projection>
+SnapshotView<T, Compare, Projection>::SnapshotView(const std::string& path, const Compare& compare, const Projection& projection)
+    : m_file(path)
+    , m_values(nullptr)
+    , m_order(nullptr)
+    , m_size(0)
+    , m_compare(compare)
+    , m_projection(projection)
+{
+    const SnapshotHeader& header = check_snapshot<T>(m_file.data(), m_file.size());
+    m_values = reinterpret_cast<const T*>(m_file.data() + sizeof(SnapshotHeader));
+    m_order = reinterpret_cast<const uint32_t*>(m_file.data() + header.m_order_offset);
+    m_size = static_cast<int>(header.m_count);
+
+    // Every rank must lead to an element
+    for (int rank = 0; rank < m_size; ++rank) {
+        if (m_order[rank] >= static_cast<uint32_t>(m_size)) {
+            throw std::runtime_error("Snapshot has a corrupt sorted order");
+        }
+    }
+}
+
+// Return the element at a position of the insertion order.
+template <typename T, typename Compare, typename Projection>
+const T& SnapshotView<T, Compare, Projection>::operator[](int pos) const
+{
+    return m_values[pos];
+}
+
+// Return the element at a rank of the sorted order.
+template <typename T, typename Compare, typename Projection>
+const T& SnapshotView<T, Compare, Projection>::sorted_at(int rank) const
+{
+    return m_values[m_order[rank]];
+}
+
+// Function checks whether an element with a key equal to the given one exists.
+template <typename T, typename Compare, typename Projection>
+bool SnapshotView<T, Compare, Projection>::contains(const key_type& key) const
+{
+    const int rank = lower_bound(key);
+    return rank < m_size && !m_compare(key, m_projection(sorted_at(rank)));
+}
+
+// Function returns the number of elements with a key equal to the given one.
+template <typename T, typename Compare, typename Projection>
+int SnapshotView<T, Compare, Projection>::count(const key_type& key) const
+{
+    return upper_bound(key) - lower_bound(key);
+}
+
+// Function returns the rank of the first element whose key is not less than the given one, by binary search over the sorted order.
+template <typename T, typename Compare, typename Projection>
+int SnapshotView<T, Compare, Projection>::lower_bound(const key_type& key) const
+{
+    int lo = 0;
+    int hi = m_size;
+    while (lo < hi) {
+        const int mid = lo + (hi - lo) / 2;
+        if (m_compare(m_projection(sorted_at(mid)), key)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Function returns the rank of the first element whose key is greater than the given one, by binary search over the sorted order.
+template <typename T, typename Compare, typename Projection>
+int SnapshotView<T, Compare, Projection>::upper_bound(const key_type& key) const
+{
+    int lo = 0;
+    int hi = m_size;
+    while (lo < hi) {
+        const int mid = lo + (hi - lo) / 2;
+        if (!m_compare(key, m_projection(sorted_at(mid)))) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Return a pointer to the first element in insertion order.
+template <typename T, typename Compare, typename Projection>
+typename SnapshotView<T, Compare, Projection>::const_iterator SnapshotView<T, Compare, Projection>::begin() const
+{
+    return m_values;
+}
+
+// Return a pointer past the last element in insertion order.
+template <typename T, typename Compare, typename Projection>
+typename SnapshotView<T, Compare, Projection>::const_iterator SnapshotView<T, Compare, Projection>::end() const
+{
+    return m_values + m_size;
+}
+
+// Checks if the snapshot is empty.
+template <typename T, typename Compare, typename Projection>
+bool SnapshotView<T, Compare, Projection>::empty() const
+{
+    return m_size == 0;
+}
+
+// Return the number of elements.
+template <typename T, typename Compare, typename Projection>
+int SnapshotView<T, Compare, Projection>::size() const
+{
+    return m_size;
+}
+
+#undef SNAPSHOT_HAS_MMAP_
+
+#endif // SNAPSHOT_IMPL_HPP_
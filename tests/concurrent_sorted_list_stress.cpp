@@ -0,0 +1,115 @@
+/* Stress test of the lock-free lookups of ConcurrentSortedList. One writer keeps inserting and removing
+   even values while readers look up odd values and walk ranges. A lookup must never report an odd
+   value, and a range walk must only pass values inside its range, in ascending order.
+   Usage: concurrent_sorted_list_stress [milliseconds] */
+
+#include "concurrent_sorted_list.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kKeyRange = 4096; // Values are drawn from [0, kKeyRange)
+constexpr int kReaders = 3;
+constexpr int kDefaultMilliseconds = 2000;
+
+std::atomic<long long> g_failures(0);
+
+// Function reports a failed check, printing only the first few.
+void fail(const char* what, int value)
+{
+    if (g_failures.fetch_add(1) < 10) {
+        std::cerr << what << " " << value << std::endl;
+    }
+}
+
+// Function keeps inserting and removing even values until told to stop.
+void write(ConcurrentSortedList<int>& list, const std::atomic<bool>& stop)
+{
+    std::mt19937 rng(1);
+    while (!stop.load(std::memory_order_relaxed)) {
+        const int value = static_cast<int>(rng() % (kKeyRange / 2)) * 2;
+        switch (rng() % 4) {
+        case 0:
+            list.push_front(value);
+            break;
+        case 1:
+            list.remove_one(value);
+            break;
+        case 2:
+            if (list.size() > kKeyRange) {
+                list.pop_front();
+            }
+            break;
+        default:
+            list.push_back(value);
+            break;
+        }
+    }
+}
+
+// Function checks lookups of odd values and range walks until told to stop.
+void read(const ConcurrentSortedList<int>& list, const std::atomic<bool>& stop, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    while (!stop.load(std::memory_order_relaxed)) {
+        const int odd = static_cast<int>(rng() % (kKeyRange / 2)) * 2 + 1;
+        if (list.contains(odd)) {
+            fail("contains() found", odd);
+        }
+        if (list.count(odd) != 0) {
+            fail("count() counted", odd);
+        }
+
+        const int low = static_cast<int>(rng() % kKeyRange);
+        const int high = low + static_cast<int>(rng() % 64);
+        int last = low;
+        list.for_each_in_range(low, high, [&](int value) {
+            if (value < low || value >= high || value % 2 != 0) {
+                fail("for_each_in_range() passed", value);
+            }
+            if (value < last) {
+                fail("for_each_in_range() went back to", value);
+            }
+            last = value;
+        });
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int milliseconds = argc > 1 ? std::atoi(argv[1]) : kDefaultMilliseconds;
+
+    ConcurrentSortedList<int> list;
+    for (int value = 0; value < kKeyRange; value += 2) {
+        list.push_back(value);
+    }
+
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> threads;
+    threads.emplace_back(write, std::ref(list), std::cref(stop));
+    for (int reader = 0; reader < kReaders; ++reader) {
+        threads.emplace_back(read, std::cref(list), std::cref(stop), 100u + reader);
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+    stop.store(true);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    if (g_failures.load() != 0) {
+        std::cerr << g_failures.load() << " failed checks" << std::endl;
+        return 1;
+    }
+    std::cout << "ok" << std::endl;
+    return 0;
+}
@@ -0,0 +1,438 @@
+/* Differential test of SelfOrganizingSortedList against the standard containers. Random operations run
+   on the list and on a model: a std::vector holding the elements in insertion order, from which the
+   expected sorted order is built as a std::multiset. After every operation both orders, positional
+   access and lookups must agree. Elements carry a stamp telling when they were created, so the order of
+   equivalent keys and the element a set keeps are checked as well.
+   Usage: sorted_list_differential [steps] */
+
+#include "self_organizing_sorted_list.hpp"
+#include "snapshot.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+constexpr int kKeyRange = 48; // Keys of the random steps are drawn from [0, kKeyRange)
+constexpr int kMaxSize = 400; // The random steps keep the list below this size
+constexpr int kBulkSize = 3 * 4096 + 517; // Large enough for assign() to split the work into 3 chunks
+constexpr int kBulkKeyRange = 2000; // Many repeated keys in a list
+constexpr int kBulkSetKeyRange = 40000; // Enough distinct keys for a set to stay large
+constexpr int kThreads = 3;
+constexpr int kDefaultSteps = 20000;
+constexpr const char* kSnapshotPath = "sorted_list_differential.snap";
+
+int g_failures = 0;
+
+struct Item
+{
+    int m_key;
+    int m_stamp; // Creation order, unique among all items
+
+    bool operator==(const Item& other) const { return m_key == other.m_key && m_stamp == other.m_stamp; }
+    bool operator!=(const Item& other) const { return !(*this == other); }
+};
+
+struct ByKey
+{
+    int operator()(const Item& item) const { return item.m_key; }
+};
+
+// Expected sorted order: ascending keys, equivalent keys newest first as if each was pushed after the others
+struct NewestFirst
+{
+    bool operator()(const Item& lhs, const Item& rhs) const
+    {
+        return lhs.m_key < rhs.m_key || (lhs.m_key == rhs.m_key && lhs.m_stamp > rhs.m_stamp);
+    }
+};
+
+template <bool UniqueKeys>
+using List = SelfOrganizingSortedList<Item, std::less<>, ByKey, UniqueKeys>;
+
+// Reference implementation: the elements in insertion order
+template <bool UniqueKeys>
+struct Model
+{
+    std::vector<Item> m_items;
+
+    // Function checks whether an item would be added, a set rejects a key it already holds.
+    bool accepts(const Item& item) const
+    {
+        return !UniqueKeys || std::none_of(m_items.begin(), m_items.end(), [&item](const Item& cur) { return cur.m_key == item.m_key; });
+    }
+
+    // Function inserts an item at a position, returns whether it was added.
+    bool insert(const Item& item, int pos)
+    {
+        if (!accepts(item)) {
+            return false;
+        }
+        m_items.insert(m_items.begin() + pos, item);
+        return true;
+    }
+
+    // Function inserts a range at a position, keeping the accepted items in order, returns how many were added.
+    int insert(const std::vector<Item>& items, int pos)
+    {
+        int added = 0;
+        for (const Item& item : items) {
+            added += insert(item, pos + added) ? 1 : 0;
+        }
+        return added;
+    }
+
+    // Function returns the items in sorted order.
+    std::multiset<Item, NewestFirst> sorted() const { return std::multiset<Item, NewestFirst>(m_items.begin(), m_items.end()); }
+};
+
+// Function reports a failed check, printing only the first few.
+void fail(const char* mode, const char* what, int step)
+{
+    if (g_failures++ < 10) {
+        std::cerr << mode << ": " << what << " at step " << step << std::endl;
+    }
+}
+
+// Function compares the list with the model: both orders, positional access and lookups.
+template <bool UniqueKeys>
+bool same(const List<UniqueKeys>& list, const Model<UniqueKeys>& model, std::mt19937& rng, int key_range = kKeyRange)
+{
+    const int size = static_cast<int>(model.m_items.size());
+    if (list.size() != size || list.empty() != (size == 0)) {
+        return false;
+    }
+    if (!std::equal(list.begin(), list.end(), model.m_items.begin(), model.m_items.end())) {
+        return false;
+    }
+    if (!std::equal(list.rbegin(), list.rend(), model.m_items.rbegin(), model.m_items.rend())) {
+        return false;
+    }
+
+    const std::multiset<Item, NewestFirst> sorted = model.sorted();
+    if (!std::equal(list.sorted_begin(), list.sorted_end(), sorted.begin(), sorted.end())) {
+        return false;
+    }
+    if (!std::equal(list.sorted_rbegin(), list.sorted_rend(), sorted.rbegin(), sorted.rend())) {
+        return false;
+    }
+
+    // Positional access at a few positions and past the end
+    for (int probe = 0; probe < 4 && size > 0; ++probe) {
+        const int pos = static_cast<int>(rng() % size);
+        if (list.at(pos) != model.m_items[pos] || list[pos] != model.m_items[pos]) {
+            return false;
+        }
+    }
+    if (size > 0 && (list.front() != model.m_items.front() || list.back() != model.m_items.back())) {
+        return false;
+    }
+    try {
+        list.at(size);
+        return false;
+    } catch (const std::out_of_range&) {
+    }
+
+    // Lookups of keys that may or may not be present, they go through the sorted express lanes
+    for (int probe = 0; probe < 4; ++probe) {
+        const int key = static_cast<int>(rng() % (key_range + 2)) - 1;
+        const int count = static_cast<int>(std::count_if(model.m_items.begin(), model.m_items.end(), [key](const Item& item) { return item.m_key == key; }));
+        if (list.count(key) != count || list.contains(key) != (count > 0)) {
+            return false;
+        }
+        const auto expected = sorted.lower_bound(Item{key, INT_MAX});
+        const auto found = list.lower_bound(key);
+        if ((expected == sorted.end()) != (found == list.sorted_end()) || (found != list.sorted_end() && *found != *expected)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Function draws a batch of new items.
+std::vector<Item> draw_items(std::mt19937& rng, int& stamp, int count, int key_range)
+{
+    std::vector<Item> items;
+    for (int i = 0; i < count; ++i) {
+        items.push_back(Item{static_cast<int>(rng() % key_range), stamp++});
+    }
+    return items;
+}
+
+// Function runs random steps on a list and its model, comparing them after every step.
+template <bool UniqueKeys>
+void run_steps(const char* mode, int steps, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    int stamp = 0;
+    List<UniqueKeys> list;
+    Model<UniqueKeys> model;
+
+    for (int step = 0; step < steps; ++step) {
+        const int size = list.size();
+        const Item item{static_cast<int>(rng() % kKeyRange), stamp++};
+
+        switch (rng() % 18) {
+        case 0:
+        case 1:
+            if (list.push_back(item) != model.insert(item, size)) {
+                fail(mode, "push_back() result", step);
+            }
+            break;
+        case 2:
+            if (list.push_front(item) != model.insert(item, 0)) {
+                fail(mode, "push_front() result", step);
+            }
+            break;
+        case 3:
+        case 4: {
+            const int pos = static_cast<int>(rng() % (size + 1));
+            if (list.insert(item, pos) != model.insert(item, pos)) {
+                fail(mode, "insert() result", step);
+            }
+            break;
+        }
+        case 5:
+            if (size > 0) {
+                const int pos = static_cast<int>(rng() % size);
+                list.erase(pos);
+                model.m_items.erase(model.m_items.begin() + pos);
+            }
+            break;
+        case 6:
+            if (size > 1) {
+                // erase() takes fewer elements than the list holds
+                const int pos = static_cast<int>(rng() % size);
+                const int count = 1 + static_cast<int>(rng() % std::min(std::min(size - pos, size - 1), 16));
+                list.erase(pos, count);
+                model.m_items.erase(model.m_items.begin() + pos, model.m_items.begin() + pos + count);
+            }
+            break;
+        case 7: {
+            const std::vector<Item> batch = draw_items(rng, stamp, static_cast<int>(rng() % 24), kKeyRange);
+            if (list.push_back_batch(batch.begin(), batch.end()) != model.insert(batch, size)) {
+                fail(mode, "push_back_batch() result", step);
+            }
+            break;
+        }
+        case 8: {
+            const std::vector<Item> batch = draw_items(rng, stamp, static_cast<int>(rng() % 24), kKeyRange);
+            const int pos = static_cast<int>(rng() % (size + 1));
+            if (list.insert_batch(pos, batch.begin(), batch.end()) != model.insert(batch, pos)) {
+                fail(mode, "insert_batch() result", step);
+            }
+            break;
+        }
+        case 9: {
+            // Build the other list with positional inserts so its insertion and sorted orders differ
+            List<UniqueKeys> other;
+            Model<UniqueKeys> other_model;
+            const int count = static_cast<int>(rng() % 32);
+            for (int i = 0; i < count; ++i) {
+                const Item extra{static_cast<int>(rng() % kKeyRange), stamp++};
+                const int pos = static_cast<int>(rng() % (other.size() + 1));
+                other.insert(extra, pos);
+                other_model.insert(extra, pos);
+            }
+            list.merge(other);
+            model.insert(other_model.m_items, size);
+            if (!other.empty()) {
+                fail(mode, "merge() left elements behind", step);
+            }
+            break;
+        }
+        case 10: {
+            // remove_one() takes the first element of the key in sorted order, the newest one
+            auto victim = model.m_items.end();
+            for (auto it = model.m_items.begin(); it != model.m_items.end(); ++it) {
+                if (it->m_key == item.m_key && (victim == model.m_items.end() || it->m_stamp > victim->m_stamp)) {
+                    victim = it;
+                }
+            }
+            if (list.remove_one(item.m_key) != (victim != model.m_items.end())) {
+                fail(mode, "remove_one() result", step);
+            }
+            if (victim != model.m_items.end()) {
+                model.m_items.erase(victim);
+            }
+            break;
+        }
+        case 11: {
+            // unique() keeps the first inserted element of every key
+            list.unique();
+            std::vector<Item> kept;
+            for (const Item& cur : model.m_items) {
+                const bool oldest = std::none_of(model.m_items.begin(), model.m_items.end(), [&cur](const Item& other) {
+                    return other.m_key == cur.m_key && other.m_stamp < cur.m_stamp;
+                });
+                if (oldest) {
+                    kept.push_back(cur);
+                }
+            }
+            model.m_items = kept;
+            break;
+        }
+        case 12: {
+            if (size == 0) {
+                break; // remove_if() rejects an empty list
+            }
+            const int divisor = 3 + static_cast<int>(rng() % 5);
+            const auto condition = [divisor](const Item& cur) { return cur.m_key % divisor == 0; };
+            list.remove_if(condition, 1 + static_cast<int>(rng() % kThreads));
+            model.m_items.erase(std::remove_if(model.m_items.begin(), model.m_items.end(), condition), model.m_items.end());
+            break;
+        }
+        case 13:
+            if (rng() % 2 == 0) {
+                list.reverse();
+                std::reverse(model.m_items.begin(), model.m_items.end());
+            } else {
+                list.sort();
+                const std::multiset<Item, NewestFirst> sorted = model.sorted();
+                model.m_items.assign(sorted.begin(), sorted.end());
+            }
+            break;
+        case 14: {
+            const List<UniqueKeys> copy(list);
+            if (!same(copy, model, rng)) {
+                fail(mode, "copy differs", step);
+            }
+            list = copy;
+            break;
+        }
+        case 15: {
+            save_snapshot(list, kSnapshotPath);
+            List<UniqueKeys> loaded;
+            loaded.push_back(Item{0, -1});
+            load_snapshot(loaded, kSnapshotPath);
+            list = std::move(loaded);
+            break;
+        }
+        case 16:
+            if (size > 0) {
+                list.pop_front();
+                model.m_items.erase(model.m_items.begin());
+            }
+            break;
+        default:
+            if (size > 0) {
+                list.pop_back();
+                model.m_items.pop_back();
+            }
+            break;
+        }
+
+        // Keep the list small enough for the model
+        if (list.size() > kMaxSize) {
+            list.erase(0, kMaxSize / 2);
+            model.m_items.erase(model.m_items.begin(), model.m_items.begin() + kMaxSize / 2);
+        }
+
+        if (!same(list, model, rng)) {
+            fail(mode, "list differs from the model", step);
+            return;
+        }
+    }
+}
+
+// Function checks the bulk paths on a list large enough to be split: serial and parallel assign, parallel
+// remove_if, merging two large lists and positional edits over the stitched express lanes.
+template <bool UniqueKeys>
+void run_bulk(const char* mode, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    int stamp = 0;
+    const int key_range = UniqueKeys ? kBulkSetKeyRange : kBulkKeyRange;
+    const std::vector<Item> items = draw_items(rng, stamp, kBulkSize, key_range);
+
+    Model<UniqueKeys> model;
+    model.insert(items, 0);
+
+    List<UniqueKeys> serial;
+    serial.assign(items.begin(), items.end());
+    if (!same(serial, model, rng, key_range)) {
+        fail(mode, "assign() differs", 0);
+    }
+
+    List<UniqueKeys> parallel;
+    parallel.push_back(Item{0, -1});
+    parallel.assign(items.begin(), items.end(), kThreads);
+    if (!same(parallel, model, rng, key_range)) {
+        fail(mode, "parallel assign() differs", 0);
+        return;
+    }
+
+    const List<UniqueKeys> constructed(items.begin(), items.end(), kThreads);
+    if (!same(constructed, model, rng, key_range)) {
+        fail(mode, "parallel constructor differs", 0);
+    }
+
+    const auto condition = [](const Item& cur) { return cur.m_key % 5 == 0; };
+    parallel.remove_if(condition, kThreads);
+    model.m_items.erase(std::remove_if(model.m_items.begin(), model.m_items.end(), condition), model.m_items.end());
+    if (!same(parallel, model, rng, key_range)) {
+        fail(mode, "parallel remove_if() differs", 0);
+        return;
+    }
+
+    const std::vector<Item> more = draw_items(rng, stamp, kBulkSize, key_range);
+    List<UniqueKeys> other;
+    other.assign(more.begin(), more.end(), kThreads);
+    parallel.merge(other);
+    model.insert(more, static_cast<int>(model.m_items.size()));
+    if (!same(parallel, model, rng, key_range)) {
+        fail(mode, "merge() of large lists differs", 0);
+        return;
+    }
+
+    for (int step = 1; step <= 200; ++step) {
+        const int size = parallel.size();
+        const int pos = static_cast<int>(rng() % (size + 1));
+        if (rng() % 2 == 0 || size == 0) {
+            const Item item{static_cast<int>(rng() % key_range), stamp++};
+            parallel.insert(item, pos);
+            model.insert(item, pos);
+        } else {
+            parallel.erase(pos % size);
+            model.m_items.erase(model.m_items.begin() + pos % size);
+        }
+        if (!same(parallel, model, rng, key_range)) {
+            fail(mode, "positional edit after bulk load differs", step);
+            return;
+        }
+    }
+
+    save_snapshot(parallel, kSnapshotPath);
+    List<UniqueKeys> loaded;
+    load_snapshot(loaded, kSnapshotPath);
+    if (!same(loaded, model, rng, key_range)) {
+        fail(mode, "snapshot round trip differs", 0);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int steps = argc > 1 ? std::atoi(argv[1]) : kDefaultSteps;
+
+    run_steps<false>("list", steps, 1u);
+    run_steps<true>("set", steps, 2u);
+    run_bulk<false>("bulk list", 3u);
+    run_bulk<true>("bulk set", 4u);
+    std::remove(kSnapshotPath);
+
+    if (g_failures != 0) {
+        std::cerr << g_failures << " failed checks" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,209 @@
+#ifndef UNROLLED_SORTED_LIST_HPP_
+#define UNROLLED_SORTED_LIST_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+/* Sorted list storing the sorted order unrolled: the keys are packed into leaves of one cache line,
+   which are indexed by groups of fences (the first key of every leaf) and by one top-level fence
+   per group. A sorted search scans three short contiguous arrays instead of chasing one pointer per
+   element. The insertion order is kept in a separate array of slots linked by 32-bit indices, each
+   slot remembers where its key currently lives.
+   Keys are moved around with plain copies, so T has to be trivially copyable. */
+template <typename T, typename Compare = std::less<>>
+class UnrolledSortedList
+{
+    static_assert(std::is_trivially_copyable<T>::value, "UnrolledSortedList requires a trivially copyable T");
+    static_assert(std::is_default_constructible<T>::value, "UnrolledSortedList requires a default constructible T");
+
+public:
+    class InsertionIterator;
+    class SortedIterator;
+
+    using value_type = T;
+    using key_compare = Compare;
+    using const_iterator = InsertionIterator; // Insertion order
+    using iterator = const_iterator;
+    using sorted_iterator = SortedIterator; // Ascending order
+    using reverse_sorted_iterator = std::reverse_iterator<sorted_iterator>;
+
+    static constexpr int kLeafSize = 64 / sizeof(T) >= 4 ? static_cast<int>(64 / sizeof(T)) : 4; // Keys per leaf, one cache line
+    static constexpr int kGroupSize = 64; // Leaves per group
+
+    // Bidirectional read-only iterator over the insertion order
+    class InsertionIterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        InsertionIterator(); // Default constructor
+        InsertionIterator(const UnrolledSortedList* list, uint32_t slot); // Iterator at a slot, kNull is the end
+
+        reference operator*() const;
+        pointer operator->() const;
+        InsertionIterator& operator++();
+        InsertionIterator operator++(int);
+        InsertionIterator& operator--();
+        InsertionIterator operator--(int);
+        bool operator==(const InsertionIterator& other) const;
+        bool operator!=(const InsertionIterator& other) const;
+
+    private:
+        const UnrolledSortedList* m_list;
+        uint32_t m_slot;
+    };
+
+    // Bidirectional read-only iterator over the sorted order
+    class SortedIterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        SortedIterator(); // Default constructor
+        SortedIterator(const UnrolledSortedList* list, uint32_t leaf, int offset); // Iterator at a key, kNull leaf is the end
+
+        reference operator*() const;
+        pointer operator->() const;
+        SortedIterator& operator++();
+        SortedIterator operator++(int);
+        SortedIterator& operator--();
+        SortedIterator operator--(int);
+        bool operator==(const SortedIterator& other) const;
+        bool operator!=(const SortedIterator& other) const;
+
+    private:
+        friend class UnrolledSortedList;
+
+        const UnrolledSortedList* m_list;
+        uint32_t m_leaf;
+        int m_offset;
+    };
+
+public:
+    UnrolledSortedList(); // Default constructor
+    explicit UnrolledSortedList(const Compare& compare); // Constructor with a comparator
+    UnrolledSortedList(std::initializer_list<T> init_list); // Constructor with initializer list
+
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    UnrolledSortedList(InputIt first, InputIt last); // Constructor with a range of values
+
+public:
+    // Modifiers
+    void push_back(const T& value); // Adds an element to the end
+    void push_front(const T& value); // Inserts an element to the beginning
+    void pop_back(); // Removes the last element
+    void pop_front(); // Removes the first element
+    void remove(const T& value); // Removes all equal elements
+    bool remove_one(const T& value); // Removes the first equal element in sorted order
+    void clear(); // Clears the contents
+    void swap(UnrolledSortedList<T, Compare>& other); // Swaps the contents
+
+    // Lookup
+    bool contains(const T& value) const; // Checks whether an equal element exists
+    sorted_iterator find(const T& value) const; // Finds the first equal element in sorted order
+    int count(const T& value) const; // Returns the number of equal elements
+    sorted_iterator lower_bound(const T& value) const; // First element not less than value
+    sorted_iterator upper_bound(const T& value) const; // First element greater than value
+
+    // Element access
+    const T& front() const; // Access the first element
+    const T& back() const; // Access the last element
+
+    // Iterators
+    const_iterator begin() const; // Insertion order
+    const_iterator end() const;
+    sorted_iterator sorted_begin() const; // Ascending order
+    sorted_iterator sorted_end() const;
+    reverse_sorted_iterator sorted_rbegin() const; // Descending order
+    reverse_sorted_iterator sorted_rend() const;
+
+    // Capacity
+    bool empty() const; // Checks whether the container is empty
+    int size() const; // Returns the number of elements
+
+private:
+    static constexpr uint32_t kNull = 0xFFFFFFFFu; // Missing slot, leaf or group
+
+    // Keys with default ordering are compared directly
+    static constexpr bool kDirectCompare = std::is_arithmetic<T>::value
+        && (std::is_same<Compare, std::less<>>::value || std::is_same<Compare, std::less<T>>::value);
+
+    struct Slot
+    {
+        uint32_t m_prev; // Previous slot in insertion order
+        uint32_t m_next; // Next slot in insertion order
+        uint32_t m_leaf; // Leaf holding the key
+        uint32_t m_offset; // Position of the key in its leaf
+    };
+
+    struct Leaf
+    {
+        alignas(64) T m_keys[kLeafSize]; // Sorted keys, the first m_count are in use
+        uint32_t m_slots[kLeafSize]; // Slot of every key
+        uint32_t m_prev; // Previous leaf in sorted order
+        uint32_t m_next; // Next leaf in sorted order
+        uint32_t m_group; // Group indexing the leaf
+        int m_count;
+    };
+
+    struct Group
+    {
+        T m_fences[kGroupSize]; // First key of every leaf
+        uint32_t m_leaves[kGroupSize]; // Leaves in sorted order
+        int m_count;
+    };
+
+    bool key_less(const T& lhs, const T& rhs) const; // Checks whether lhs is ordered before rhs
+    int count_less(const T* keys, int count, const T& key) const; // Branch-free count of the keys less than key
+    int count_not_greater(const T* keys, int count, const T& key) const; // Branch-free count of the keys not greater than key
+
+    SortedIterator locate(const T& key, bool after_equal) const; // First key not less (greater, if after_equal) than key
+    void insert_key(const T& key, uint32_t slot); // Puts a key into the sorted order
+    void erase_key(uint32_t leaf, int offset); // Takes a key out of the sorted order
+    void erase_slot(uint32_t slot); // Removes an element from both orders
+
+    uint32_t new_slot(); // Takes a free slot
+    uint32_t new_leaf(); // Takes a free leaf
+    uint32_t new_group(); // Takes a free group
+    uint32_t split_leaf(uint32_t leaf, int keep); // Moves the keys after the first 'keep' of a full leaf into a new one
+    void split_group(uint32_t group); // Moves the upper half of a full group into a new one
+    void update_fences(uint32_t leaf, const T& old_first); // Propagates a changed first key of a leaf
+    int leaf_position(uint32_t leaf) const; // Position of a leaf in its group
+    size_t group_position(uint32_t group, const T& fence) const; // Position of a group in the top-level index
+    template <typename Value>
+    static void reserve_for(std::vector<Value>& values, size_t count); // Grows the capacity geometrically
+
+    uint32_t first_leaf() const;
+    uint32_t last_leaf() const;
+
+private:
+    std::vector<Slot> m_slots; // Insertion order records
+    std::vector<Leaf> m_leaves; // Key storage
+    std::vector<Group> m_groups; // Leaf index
+    std::vector<uint32_t> m_free_slots;
+    std::vector<uint32_t> m_free_leaves;
+    std::vector<uint32_t> m_free_groups;
+    std::vector<T> m_fences; // First key of every group, in sorted order
+    std::vector<uint32_t> m_order; // Groups in sorted order
+    uint32_t m_head; // First slot in insertion order
+    uint32_t m_tail; // Last slot in insertion order
+    int m_size;
+    Compare m_compare; // Orders the keys
+};
+
+#include "unrolled_sorted_list_impl_.hpp"
+
+#endif // UNROLLED_SORTED_LIST_HPP_
@@ -0,0 +1,863 @@
+#ifndef UNROLLED_SORTED_LIST_IMPL_HPP_
+#define UNROLLED_SORTED_LIST_IMPL_HPP_
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+// Default constructor
+template <typename T, typename Compare>
+UnrolledSortedList<T, Compare>::UnrolledSortedList()
+    : UnrolledSortedList(Compare())
+{
+}
+
+// Constructor with a comparator
+template <typename T, typename Compare>
+UnrolledSortedList<T, Compare>::UnrolledSortedList(const Compare& compare)
+    : m_slots()
+    , m_leaves()
+    , m_groups()
+    , m_free_slots()
+    , m_free_leaves()
+    , m_free_groups()
+    , m_fences()
+    , m_order()
+    , m_head(kNull)
+    , m_tail(kNull)
+    , m_size(0)
+    , m_compare(compare)
+{
+}
+
+// Constructor with initializer list
+template <typename T, typename Compare>
+UnrolledSortedList<T, Compare>::UnrolledSortedList(std::initializer_list<T> init_list)
+    : UnrolledSortedList(init_list.begin(), init_list.end())
+{
+}
+
+// Constructor with a range of values
+template <typename T, typename Compare>
+template <typename InputIt, typename>
+UnrolledSortedList<T, Compare>::UnrolledSortedList(InputIt first, InputIt last)
+    : UnrolledSortedList()
+{
+    for (; first != last; ++first) {
+        push_back(*first);
+    }
+}
+
+// Adds an element to the end of the insertion order.
+template <typename T, typename Compare>
+void UnrolledSortedList<T, Compare>::push_back(const T& value)
+{
+    const uint32_t slot = new_slot();
+    try {
+        insert_key(value, slot);
+    } catch (...) {
+        m_free_slots.push_back(slot);
+        throw;
+    }
+
+    // Link the slot behind the tail
+    Slot& elem = m_slots[slot];
+    elem.m_prev = m_tail;
+    elem.m_next = kNull;
+    if (m_tail != kNull) {
+        m_slots[m_tail].m_next = slot;
+    } else {
+        m_head = slot;
+    }
+    m_tail = slot;
+    ++m_size;
+}
+
+// Adds an element to the front of the insertion order.
+template <typename T, typename Compare>
+void UnrolledSortedList<T, Compare>::push_front(const T& value)
+{
+    const uint32_t slot = new_slot();
+    try {
+        insert_key(value, slot);
+    } catch (...) {
+        m_free_slots.push_back(slot);
+        throw;
+    }
+
+    // Link the slot before the head
+    Slot& elem = m_slots[slot];
+    elem.m_prev = kNull;
+    elem.m_next = m_head;
+    if (m_head != kNull) {
+        m_slots[m_head].m_prev = slot;
+    } else {
+        m_tail = slot;
+    }
+    m_head = slot;
+    ++m_size;
+}
+
+// Removes the last element in insertion order.
+template <typename T, typename Compare>
+void UnrolledSortedList<T, Compare>::pop_back()
+{
+    // Check if the list is empty
+    if (m_tail == kNull) {
+        throw std::runtime_error("List is empty. Cannot pop_back()");
+    }
+
+    erase_slot(m_tail);
+}
+
+// Removes the first element in insertion order.
+template <typename T, typename Compare>
+void UnrolledSortedList<T, Compare>::pop_front()
+{
+    // Check if the list is empty
+    if (m_head == kNull) {
+        throw std::runtime_error("List is empty. Cannot pop_front()");
+    }
+
+    erase_slot(m_head);
+}
+
+// Function removes all elements equal to the given value, one search per removed element.
+template <typename T, typename Compare>
+void UnrolledSortedList<T, Compare>::remove(const T& value)
+{
+    while (remove_one(value)) {
+    }
+}
+
+// Function removes the first element equal to the given value in sorted order, returns whether one was found.
+template <typename T, typename Compare>
+bool UnrolledSortedList<T, Compare>::remove_one(const T& value)
+{
+    const sorted_iterator it = find(value);
+    if (it == sorted_end()) {
+        return false;
+    }
+
+    erase_slot(m_leaves[it.m_leaf].m_slots[it.m_offset]);
+    return true;
+}
+
+// Removes all elements, the storage is released.
+template <typename T, typename Compare>
+void UnrolledSortedList<T, Compare>::clear()
+{
+    UnrolledSortedList<T, Compare> empty(m_compare);
+    swap(empty);
+}
+
+// Swaps the contents.
+template <typename T, typename Compare>
+void UnrolledSortedList<T, Compare>::swap(UnrolledSortedList<T, Compare>& other)
+{
+    m_slots.swap(other.m_slots);
+    m_leaves.swap(other.m_leaves);
+    m_groups.swap(other.m_groups);
+    m_free_slots.swap(other.m_free_slots);
+    m_free_leaves.swap(other.m_free_leaves);
+    m_free_groups.swap(other.m_free_groups);
+    m_fences.swap(other.m_fences);
+    m_order.swap(other.m_order);
+    std::swap(m_head, other.m_head);
+    std::swap(m_tail, other.m_tail);
+    std::swap(m_size, other.m_size);
+    std::swap(m_compare, other.m_compare);
+}
+
+// Function checks whether an element equal to the value exists.
+template <typename T, typename Compare>
+bool UnrolledSortedList<T, Compare>::contains(const T& value) const
+{
+    return find(value) != sorted_end();
+}
+
+// Function returns the first element equal to the value in sorted order, or sorted_end() if there is none.
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::sorted_iterator UnrolledSortedList<T, Compare>::find(const T& value) const
+{
+    sorted_iterator it = lower_bound(value);
+
+    // The first element not less than the value is a match unless it is greater
+    if (it != sorted_end() && key_less(value, *it)) {
+        return sorted_end();
+    }
+    return it;
+}
+
+// Function returns the number of elements equal to the value.
+template <typename T, typename Compare>
+int UnrolledSortedList<T, Compare>::count(const T& value) const
+{
+    int result = 0;
+    for (sorted_iterator it = lower_bound(value); it != sorted_end() && !key_less(value, *it); ++it) {
+        ++result;
+    }
+    return result;
+}
+
+// Function returns the first element in sorted order that is not less than the value.
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::sorted_iterator UnrolledSortedList<T, Compare>::lower_bound(const T& value) const
+{
+    return locate(value, false);
+}
+
+// Function returns the first element in sorted order that is greater than the value.
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::sorted_iterator UnrolledSortedList<T, Compare>::upper_bound(const T& value) const
+{
+    return locate(value, true);
+}
+
+// Return a reference to the first element in insertion order.
+template <typename T, typename Compare>
+const T& UnrolledSortedList<T, Compare>::front() const
+{
+    return *begin();
+}
+
+// Return a reference to the last element in insertion order.
+template <typename T, typename Compare>
+const T& UnrolledSortedList<T, Compare>::back() const
+{
+    return *const_iterator(this, m_tail);
+}
+
+// Return an iterator to the first element in insertion order.
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::const_iterator UnrolledSortedList<T, Compare>::begin() const
+{
+    return const_iterator(this, m_head);
+}
+
+// Return an iterator past the last element in insertion order.
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::const_iterator UnrolledSortedList<T, Compare>::end() const
+{
+    return const_iterator(this, kNull);
+}
+
+// Return an iterator to the smallest element.
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::sorted_iterator UnrolledSortedList<T, Compare>::sorted_begin() const
+{
+    return sorted_iterator(this, first_leaf(), 0);
+}
+
+// Return an iterator past the largest element.
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::sorted_iterator UnrolledSortedList<T, Compare>::sorted_end() const
+{
+    return sorted_iterator(this, kNull, 0);
+}
+
+// Return a reverse iterator to the largest element.
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::reverse_sorted_iterator UnrolledSortedList<T, Compare>::sorted_rbegin() const
+{
+    return reverse_sorted_iterator(sorted_end());
+}
+
+// Return a reverse iterator past the smallest element.
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::reverse_sorted_iterator UnrolledSortedList<T, Compare>::sorted_rend() const
+{
+    return reverse_sorted_iterator(sorted_begin());
+}
+
+// Checks if the list is empty.
+template <typename T, typename Compare>
+bool UnrolledSortedList<T, Compare>::empty() const
+{
+    return m_size == 0;
+}
+
+// Return the number of elements.
+template <typename T, typename Compare>
+int UnrolledSortedList<T, Compare>::size() const
+{
+    return m_size;
+}
+
+// Function checks whether 'lhs' is ordered before 'rhs', arithmetic keys under the default ordering are compared directly.
+template <typename T, typename Compare>
+bool UnrolledSortedList<T, Compare>::key_less(const T& lhs, const T& rhs) const
+{
+    if constexpr (kDirectCompare) {
+        return lhs < rhs;
+    } else {
+        return m_compare(lhs, rhs);
+    }
+}
+
+// Function counts the keys less than 'key'. The loop has no data dependent branch, so the whole
+// cache line is scanned at memory speed and compilers turn it into SIMD compares for arithmetic keys.
+template <typename T, typename Compare>
+int UnrolledSortedList<T, Compare>::count_less(const T* keys, int count, const T& key) const
+{
+    int result = 0;
+    for (int i = 0; i < count; ++i) {
+        result += key_less(keys[i], key) ? 1 : 0;
+    }
+    return result;
+}
+
+// Function counts the keys not greater than 'key', without data dependent branches.
+template <typename T, typename Compare>
+int UnrolledSortedList<T, Compare>::count_not_greater(const T* keys, int count, const T& key) const
+{
+    int result = 0;
+    for (int i = 0; i < count; ++i) {
+        result += key_less(key, keys[i]) ? 0 : 1;
+    }
+    return result;
+}
+
+/* Function returns the first key not less than 'key', or the first key greater than it if 'after_equal'.
+   Every level is entered at the last entry whose fence comes before the key: all later entries only hold
+   keys that come after it, so the answer is inside that entry or is the first key of the next leaf. */
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::SortedIterator UnrolledSortedList<T, Compare>::locate(const T& key, bool after_equal) const
+{
+    if (m_order.empty()) {
+        return sorted_end();
+    }
+
+    // The top level can be long, search it with a binary search
+    auto less = [this](const T& lhs, const T& rhs) {
+        return key_less(lhs, rhs);
+    };
+    const size_t top = after_equal ? std::upper_bound(m_fences.begin(), m_fences.end(), key, less) - m_fences.begin()
+                                   : std::lower_bound(m_fences.begin(), m_fences.end(), key, less) - m_fences.begin();
+    const Group& group = m_groups[m_order[top > 0 ? top - 1 : 0]];
+
+    // Groups and leaves are scanned
+    const int fence = after_equal ? count_not_greater(group.m_fences, group.m_count, key) : count_less(group.m_fences, group.m_count, key);
+    const uint32_t leaf = group.m_leaves[fence > 0 ? fence - 1 : 0];
+    const Leaf& keys = m_leaves[leaf];
+    const int pos = after_equal ? count_not_greater(keys.m_keys, keys.m_count, key) : count_less(keys.m_keys, keys.m_count, key);
+
+    // Every key of the leaf comes before the searched one, the answer starts the next leaf
+    if (pos == keys.m_count) {
+        return sorted_iterator(this, keys.m_next, 0);
+    }
+    return sorted_iterator(this, leaf, pos);
+}
+
+/* Function puts a key into the sorted order in front of the equal keys, like the self-organizing list
+   does, and records its location in 'slot'. A full leaf is split in two first. */
+template <typename T, typename Compare>
+void UnrolledSortedList<T, Compare>::insert_key(const T& key, uint32_t slot)
+{
+    if (m_order.empty()) {
+        // The first key gets a leaf and a group of its own
+        m_fences.reserve(1);
+        m_order.reserve(1);
+        const uint32_t leaf = new_leaf();
+        const uint32_t group = new_group();
+
+        Leaf& first = m_leaves[leaf];
+        first.m_keys[0] = key;
+        first.m_slots[0] = slot;
+        first.m_count = 1;
+        first.m_prev = kNull;
+        first.m_next = kNull;
+        first.m_group = group;
+
+        Group& index = m_groups[group];
+        index.m_fences[0] = key;
+        index.m_leaves[0] = leaf;
+        index.m_count = 1;
+
+        m_fences.push_back(key);
+        m_order.push_back(group);
+        m_slots[slot].m_leaf = leaf;
+        m_slots[slot].m_offset = 0;
+        return;
+    }
+
+    // A new maximum is appended to the last leaf without searching
+    uint32_t leaf = last_leaf();
+    int pos = m_leaves[leaf].m_count;
+    if (!key_less(m_leaves[leaf].m_keys[pos - 1], key)) {
+        // Find the first key not less than the new one, there is one since the largest key is
+        const sorted_iterator it = locate(key, false);
+        if (it.m_offset == 0 && m_leaves[it.m_leaf].m_prev != kNull) {
+            // At the start of a leaf, append to the previous one instead so that no fence changes
+            leaf = m_leaves[it.m_leaf].m_prev;
+            pos = m_leaves[leaf].m_count;
+        } else {
+            leaf = it.m_leaf;
+            pos = it.m_offset;
+        }
+    }
+
+    // Make room, the key goes to the half that covers its position
+    if (m_leaves[leaf].m_count == kLeafSize) {
+        // Appending behind the largest key keeps the lower leaf full, so ascending input packs the leaves
+        const bool append = pos == kLeafSize && m_leaves[leaf].m_next == kNull;
+        const uint32_t upper = split_leaf(leaf, append ? kLeafSize - 1 : kLeafSize / 2);
+        const int lower_count = m_leaves[leaf].m_count;
+        if (pos > lower_count) {
+            leaf = upper;
+            pos -= lower_count;
+        }
+    }
+
+    Leaf& target = m_leaves[leaf];
+    const T old_first = target.m_keys[0];
+
+    // Shift the greater keys up by one and store the new key
+    std::copy_backward(target.m_keys + pos, target.m_keys + target.m_count, target.m_keys + target.m_count + 1);
+    std::copy_backward(target.m_slots + pos, target.m_slots + target.m_count, target.m_slots + target.m_count + 1);
+    target.m_keys[pos] = key;
+    target.m_slots[pos] = slot;
+    ++target.m_count;
+
+    // The shifted keys moved within the leaf
+    for (int i = pos; i < target.m_count; ++i) {
+        m_slots[target.m_slots[i]].m_leaf = leaf;
+        m_slots[target.m_slots[i]].m_offset = i;
+    }
+
+    if (pos == 0) {
+        update_fences(leaf, old_first);
+    }
+}
+
+// Function takes the key at 'offset' out of a leaf, a leaf left empty is released.
+template <typename T, typename Compare>
+void UnrolledSortedList<T, Compare>::erase_key(uint32_t leaf, int offset)
+{
+    Leaf& source = m_leaves[leaf];
+    const T old_first = source.m_keys[0];
+
+    // Shift the greater keys down by one
+    std::copy(source.m_keys + offset + 1, source.m_keys + source.m_count, source.m_keys + offset);
+    std::copy(source.m_slots + offset + 1, source.m_slots + source.m_count, source.m_slots + offset);
+    --source.m_count;
+    for (int i = offset; i < source.m_count; ++i) {
+        m_slots[source.m_slots[i]].m_offset = i;
+    }
+
+    if (source.m_count > 0) {
+        if (offset == 0) {
+            update_fences(leaf, old_first);
+        }
+        return;
+    }
+
+    // Unlink the empty leaf from the chain of leaves
+    if (source.m_prev != kNull) {
+        m_leaves[source.m_prev].m_next = source.m_next;
+    }
+    if (source.m_next != kNull) {
+        m_leaves[source.m_next].m_prev = source.m_prev;
+    }
+
+    // Remove it from its group
+    const uint32_t group = source.m_group;
+    Group& index = m_groups[group];
+    const T old_fence = index.m_fences[0];
+    const int li = leaf_position(leaf);
+    std::copy(index.m_fences + li + 1, index.m_fences + index.m_count, index.m_fences + li);
+    std::copy(index.m_leaves + li + 1, index.m_leaves + index.m_count, index.m_leaves + li);
+    --index.m_count;
+    m_free_leaves.push_back(leaf);
+
+    // Remove an empty group from the top level, or follow its new first key
+    const size_t gi = group_position(group, old_fence);
+    if (index.m_count == 0) {
+        m_fences.erase(m_fences.begin() + gi);
+        m_order.erase(m_order.begin() + gi);
+        m_free_groups.push_back(group);
+    } else if (li == 0) {
+        m_fences[gi] = index.m_fences[0];
+    }
+}
+
+// Function removes an element from the sorted order and from the insertion order.
+template <typename T, typename Compare>
+void UnrolledSortedList<T, Compare>::erase_slot(uint32_t slot)
+{
+    Slot& elem = m_slots[slot];
+    erase_key(elem.m_leaf, elem.m_offset);
+
+    // Unlink from the insertion order
+    if (elem.m_prev != kNull) {
+        m_slots[elem.m_prev].m_next = elem.m_next;
+    } else {
+        m_head = elem.m_next;
+    }
+    if (elem.m_next != kNull) {
+        m_slots[elem.m_next].m_prev = elem.m_prev;
+    } else {
+        m_tail = elem.m_prev;
+    }
+
+    m_free_slots.push_back(slot);
+    --m_size;
+}
+
+// Function returns a free slot, reusing a released one if possible.
+template <typename T, typename Compare>
+uint32_t UnrolledSortedList<T, Compare>::new_slot()
+{
+    // Reserve the free list entry now, so that releasing the slot later cannot fail
+    reserve_for(m_free_slots, m_slots.size() + 1);
+
+    if (!m_free_slots.empty()) {
+        const uint32_t slot = m_free_slots.back();
+        m_free_slots.pop_back();
+        return slot;
+    }
+    m_slots.push_back(Slot());
+    return static_cast<uint32_t>(m_slots.size() - 1);
+}
+
+// Function returns a free leaf, reusing a released one if possible.
+template <typename T, typename Compare>
+uint32_t UnrolledSortedList<T, Compare>::new_leaf()
+{
+    reserve_for(m_free_leaves, m_leaves.size() + 1);
+
+    if (!m_free_leaves.empty()) {
+        const uint32_t leaf = m_free_leaves.back();
+        m_free_leaves.pop_back();
+        return leaf;
+    }
+    m_leaves.push_back(Leaf());
+    return static_cast<uint32_t>(m_leaves.size() - 1);
+}
+
+// Function returns a free group, reusing a released one if possible.
+template <typename T, typename Compare>
+uint32_t UnrolledSortedList<T, Compare>::new_group()
+{
+    reserve_for(m_free_groups, m_groups.size() + 1);
+
+    if (!m_free_groups.empty()) {
+        const uint32_t group = m_free_groups.back();
+        m_free_groups.pop_back();
+        return group;
+    }
+    m_groups.push_back(Group());
+    return static_cast<uint32_t>(m_groups.size() - 1);
+}
+
+// Function keeps the first 'keep' keys of a full leaf and moves the others into a new leaf right after it,
+// returns the new leaf.
+template <typename T, typename Compare>
+uint32_t UnrolledSortedList<T, Compare>::split_leaf(uint32_t leaf, int keep)
+{
+    // The group gets another leaf, split it first if it is full
+    if (m_groups[m_leaves[leaf].m_group].m_count == kGroupSize) {
+        split_group(m_leaves[leaf].m_group);
+    }
+
+    // Taking a leaf may move the others, get the references afterwards
+    const uint32_t upper = new_leaf();
+    Leaf& lower_half = m_leaves[leaf];
+    Leaf& upper_half = m_leaves[upper];
+
+    upper_half.m_count = lower_half.m_count - keep;
+    std::copy(lower_half.m_keys + keep, lower_half.m_keys + lower_half.m_count, upper_half.m_keys);
+    std::copy(lower_half.m_slots + keep, lower_half.m_slots + lower_half.m_count, upper_half.m_slots);
+    lower_half.m_count = keep;
+    for (int i = 0; i < upper_half.m_count; ++i) {
+        m_slots[upper_half.m_slots[i]].m_leaf = upper;
+        m_slots[upper_half.m_slots[i]].m_offset = i;
+    }
+
+    // Link the new leaf after the old one
+    upper_half.m_prev = leaf;
+    upper_half.m_next = lower_half.m_next;
+    if (lower_half.m_next != kNull) {
+        m_leaves[lower_half.m_next].m_prev = upper;
+    }
+    lower_half.m_next = upper;
+
+    // Index it in the same group, right after the old one
+    upper_half.m_group = lower_half.m_group;
+    Group& index = m_groups[upper_half.m_group];
+    const int li = leaf_position(leaf);
+    std::copy_backward(index.m_fences + li + 1, index.m_fences + index.m_count, index.m_fences + index.m_count + 1);
+    std::copy_backward(index.m_leaves + li + 1, index.m_leaves + index.m_count, index.m_leaves + index.m_count + 1);
+    index.m_fences[li + 1] = upper_half.m_keys[0];
+    index.m_leaves[li + 1] = upper;
+    ++index.m_count;
+
+    return upper;
+}
+
+// Function moves the upper half of a full group into a new group right after it in the top level.
+template <typename T, typename Compare>
+void UnrolledSortedList<T, Compare>::split_group(uint32_t group)
+{
+    // Make sure the top level can grow before anything is moved
+    reserve_for(m_fences, m_fences.size() + 1);
+    reserve_for(m_order, m_order.size() + 1);
+
+    // Taking a group may move the others, get the references afterwards
+    const uint32_t upper = new_group();
+    Group& lower_half = m_groups[group];
+    Group& upper_half = m_groups[upper];
+
+    const int half = lower_half.m_count / 2;
+    upper_half.m_count = lower_half.m_count - half;
+    std::copy(lower_half.m_fences + half, lower_half.m_fences + lower_half.m_count, upper_half.m_fences);
+    std::copy(lower_half.m_leaves + half, lower_half.m_leaves + lower_half.m_count, upper_half.m_leaves);
+    lower_half.m_count = half;
+    for (int i = 0; i < upper_half.m_count; ++i) {
+        m_leaves[upper_half.m_leaves[i]].m_group = upper;
+    }
+
+    const size_t gi = group_position(group, lower_half.m_fences[0]);
+    m_fences.insert(m_fences.begin() + gi + 1, upper_half.m_fences[0]);
+    m_order.insert(m_order.begin() + gi + 1, upper);
+}
+
+// Function updates the fences after the first key of a leaf changed from 'old_first'.
+template <typename T, typename Compare>
+void UnrolledSortedList<T, Compare>::update_fences(uint32_t leaf, const T& old_first)
+{
+    const Leaf& source = m_leaves[leaf];
+    Group& index = m_groups[source.m_group];
+    const int li = leaf_position(leaf);
+    index.m_fences[li] = source.m_keys[0];
+
+    // The first leaf of a group also gives the fence of the group
+    if (li == 0) {
+        m_fences[group_position(source.m_group, old_first)] = source.m_keys[0];
+    }
+}
+
+// Function returns the position of a leaf in its group.
+template <typename T, typename Compare>
+int UnrolledSortedList<T, Compare>::leaf_position(uint32_t leaf) const
+{
+    const Group& index = m_groups[m_leaves[leaf].m_group];
+    int li = 0;
+    while (index.m_leaves[li] != leaf) {
+        ++li;
+    }
+    return li;
+}
+
+// Function returns the position of a group in the top level, given its current fence.
+template <typename T, typename Compare>
+size_t UnrolledSortedList<T, Compare>::group_position(uint32_t group, const T& fence) const
+{
+    auto less = [this](const T& lhs, const T& rhs) {
+        return key_less(lhs, rhs);
+    };
+
+    // Groups with the same fence are adjacent, the group is among them
+    size_t gi = std::lower_bound(m_fences.begin(), m_fences.end(), fence, less) - m_fences.begin();
+    while (m_order[gi] != group) {
+        ++gi;
+    }
+    return gi;
+}
+
+// Function makes sure a vector can hold 'count' elements without reallocating, growing it geometrically.
+template <typename T, typename Compare>
+template <typename Value>
+void UnrolledSortedList<T, Compare>::reserve_for(std::vector<Value>& values, size_t count)
+{
+    if (values.capacity() < count) {
+        values.reserve(std::max(count, 2 * values.capacity()));
+    }
+}
+
+// Return the leaf holding the smallest keys.
+template <typename T, typename Compare>
+uint32_t UnrolledSortedList<T, Compare>::first_leaf() const
+{
+    return m_order.empty() ? kNull : m_groups[m_order.front()].m_leaves[0];
+}
+
+// Return the leaf holding the largest keys.
+template <typename T, typename Compare>
+uint32_t UnrolledSortedList<T, Compare>::last_leaf() const
+{
+    if (m_order.empty()) {
+        return kNull;
+    }
+    const Group& index = m_groups[m_order.back()];
+    return index.m_leaves[index.m_count - 1];
+}
+
+// Default constructor
+template <typename T, typename Compare>
+UnrolledSortedList<T, Compare>::InsertionIterator::InsertionIterator()
+    : m_list(nullptr)
+    , m_slot(kNull)
+{
+}
+
+// Constructor with the list and the current slot
+template <typename T, typename Compare>
+UnrolledSortedList<T, Compare>::InsertionIterator::InsertionIterator(const UnrolledSortedList* list, uint32_t slot)
+    : m_list(list)
+    , m_slot(slot)
+{
+}
+
+// Return a reference to the current element.
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::InsertionIterator::reference UnrolledSortedList<T, Compare>::InsertionIterator::operator*() const
+{
+    const Slot& elem = m_list->m_slots[m_slot];
+    return m_list->m_leaves[elem.m_leaf].m_keys[elem.m_offset];
+}
+
+// Return a pointer to the current element.
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::InsertionIterator::pointer UnrolledSortedList<T, Compare>::InsertionIterator::operator->() const
+{
+    return &**this;
+}
+
+// Moves to the following element in insertion order.
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::InsertionIterator& UnrolledSortedList<T, Compare>::InsertionIterator::operator++()
+{
+    m_slot = m_list->m_slots[m_slot].m_next;
+    return *this;
+}
+
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::InsertionIterator UnrolledSortedList<T, Compare>::InsertionIterator::operator++(int)
+{
+    InsertionIterator tmp = *this;
+    ++*this;
+    return tmp;
+}
+
+// Moves to the preceding element in insertion order, the end moves to the last element.
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::InsertionIterator& UnrolledSortedList<T, Compare>::InsertionIterator::operator--()
+{
+    m_slot = m_slot == kNull ? m_list->m_tail : m_list->m_slots[m_slot].m_prev;
+    return *this;
+}
+
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::InsertionIterator UnrolledSortedList<T, Compare>::InsertionIterator::operator--(int)
+{
+    InsertionIterator tmp = *this;
+    --*this;
+    return tmp;
+}
+
+// Checks that both iterators point to the same element
+template <typename T, typename Compare>
+bool UnrolledSortedList<T, Compare>::InsertionIterator::operator==(const InsertionIterator& other) const
+{
+    return m_slot == other.m_slot;
+}
+
+// Checks that the iterators point to different elements
+template <typename T, typename Compare>
+bool UnrolledSortedList<T, Compare>::InsertionIterator::operator!=(const InsertionIterator& other) const
+{
+    return !(*this == other);
+}
+
+// Default constructor
+template <typename T, typename Compare>
+UnrolledSortedList<T, Compare>::SortedIterator::SortedIterator()
+    : m_list(nullptr)
+    , m_leaf(kNull)
+    , m_offset(0)
+{
+}
+
+// Constructor with the list, the current leaf and the position in it
+template <typename T, typename Compare>
+UnrolledSortedList<T, Compare>::SortedIterator::SortedIterator(const UnrolledSortedList* list, uint32_t leaf, int offset)
+    : m_list(list)
+    , m_leaf(leaf)
+    , m_offset(offset)
+{
+}
+
+// Return a reference to the current element.
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::SortedIterator::reference UnrolledSortedList<T, Compare>::SortedIterator::operator*() const
+{
+    return m_list->m_leaves[m_leaf].m_keys[m_offset];
+}
+
+// Return a pointer to the current element.
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::SortedIterator::pointer UnrolledSortedList<T, Compare>::SortedIterator::operator->() const
+{
+    return &**this;
+}
+
+// Moves to the following element in sorted order, crossing into the next leaf at the end of a leaf.
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::SortedIterator& UnrolledSortedList<T, Compare>::SortedIterator::operator++()
+{
+    const Leaf& leaf = m_list->m_leaves[m_leaf];
+    if (++m_offset == leaf.m_count) {
+        m_leaf = leaf.m_next;
+        m_offset = 0;
+    }
+    return *this;
+}
+
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::SortedIterator UnrolledSortedList<T, Compare>::SortedIterator::operator++(int)
+{
+    SortedIterator tmp = *this;
+    ++*this;
+    return tmp;
+}
+
+// Moves to the preceding element in sorted order, the end moves to the largest element.
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::SortedIterator& UnrolledSortedList<T, Compare>::SortedIterator::operator--()
+{
+    if (m_leaf == kNull) {
+        m_leaf = m_list->last_leaf();
+        m_offset = m_list->m_leaves[m_leaf].m_count - 1;
+    } else if (m_offset == 0) {
+        m_leaf = m_list->m_leaves[m_leaf].m_prev;
+        m_offset = m_list->m_leaves[m_leaf].m_count - 1;
+    } else {
+        --m_offset;
+    }
+    return *this;
+}
+
+template <typename T, typename Compare>
+typename UnrolledSortedList<T, Compare>::SortedIterator UnrolledSortedList<T, Compare>::SortedIterator::operator--(int)
+{
+    SortedIterator tmp = *this;
+    --*this;
+    return tmp;
+}
+
+// Checks that both iterators point to the same element
+template <typename T, typename Compare>
+bool UnrolledSortedList<T, Compare>::SortedIterator::operator==(const SortedIterator& other) const
+{
+    return m_leaf == other.m_leaf && m_offset == other.m_offset;
+}
+
+// Checks that the iterators point to different elements
+template <typename T, typename Compare>
+bool UnrolledSortedList<T, Compare>::SortedIterator::operator!=(const SortedIterator& other) const
+{
+    return !(*this == other);
+}
+
+#endif // UNROLLED_SORTED_LIST_IMPL_HPP_